@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AIBudgetScheduler.h"
+
+void FAIBudgetScheduler::BeginFrame(float inBudgetMs)
+{
+	if (frameOpen)
+	{
+		stats.frames++;
+		stats.lastFrameMs = frameMs;
+		if (frameMs > budgetMs)
+			stats.framesOverBudget++;
+	}
+
+	frameOpen = true;
+	budgetMs = inBudgetMs;
+	frameMs = 0.0;
+}
+
+int32 FAIBudgetScheduler::GetSlots(int32 forcedCount) const
+{
+	const double leftMs = budgetMs - forcedCount * averageMs;
+
+	// At least one so every enemy still gets its turn when the forced ones eat the whole budget
+	return FMath::Max(FMath::FloorToInt(leftMs / averageMs), 1);
+}
+
+void FAIBudgetScheduler::Report(double seconds)
+{
+	const double ms = seconds * 1000.0;
+	frameMs += ms;
+
+	// Moving average, a single hitch does not starve the next frames
+	averageMs = FMath::Max(FMath::Lerp(averageMs, ms, 0.1), 0.001);
+	stats.averageEvaluationMs = averageMs;
+}
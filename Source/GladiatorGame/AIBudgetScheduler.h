@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIBudgetScheduler.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAIBudgetStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		int frames = 0;
+
+	/** Frames where the measured evaluations went over the budget */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		int framesOverBudget = 0;
+
+	/** Enemy evaluations pushed to a later frame */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		int deferredEvaluations = 0;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		float lastFrameMs = 0.f;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		float averageEvaluationMs = 0.f;
+};
+
+/**
+ * Decides how many enemies may run their expensive evaluations this frame from a budget in milliseconds.
+ * The cost of an evaluation is learnt from the ones measured with FAIBudgetScope.
+ */
+struct GLADIATORGAME_API FAIBudgetScheduler
+{
+	FAIBudgetStats stats;
+
+	/** Round robin position among the enemies that are not run every frame */
+	int32 cursor = 0;
+
+	/** Closes the last frame into the stats */
+	void BeginFrame(float budgetMs);
+
+	/** Evaluations that still fit in the budget once the forced ones are paid for, never less than one */
+	int32 GetSlots(int32 forcedCount) const;
+
+	void Report(double seconds);
+
+	void AddDeferred(int32 count) { stats.deferredEvaluations += count; }
+
+private:
+	float budgetMs = 0.f;
+	double frameMs = 0.0;
+	double averageMs = 0.05;
+	bool frameOpen = false;
+};
+
+/** Measures one evaluation for the scheduler, does nothing without one */
+struct FAIBudgetScope
+{
+	FAIBudgetScheduler* scheduler;
+	uint64 startCycles;
+
+	explicit FAIBudgetScope(FAIBudgetScheduler* inScheduler)
+		: scheduler(inScheduler), startCycles(inScheduler ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FAIBudgetScope()
+	{
+		if (scheduler)
+			scheduler->Report(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - startCycles));
+	}
+};
@@ -2,6 +2,9 @@
 
 
 #include "AIC_Enemy.h"
+#include "GladiatorGame.h"
+#include "AIEventLog.h"
+#include "GladiatorStats.h"
 #include "EnemyCharacter.h"
 #include "LifeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -11,7 +14,28 @@
 #include "Kismet/GameplayStatics.h"
 #include "Navigation/CrowdFollowingComponent.h"
 #include "AIEnemyManager.h"
-#include "EngineUtils.h"
+#include "EnemyAISubsystem.h"
+
+namespace
+{
+	using EState = EEnemyMovingState;
+	constexpr EState NoTransition = EEnemyMovingState::COUNT;
+
+	// Rows are the current state, columns the events in EEnemyAIEvent order, NoTransition keeps the current state
+	const EEnemyMovingState transitionTable[(uint8)EState::COUNT][(uint8)EEnemyAIEvent::COUNT] =
+	{
+		// OUT_OF_RANGE, STOPPED, NEEDS_PLACE, PLACE_CHOSEN, PLACE_REACHED, TOO_CLOSE, BACK_IN_RANGE, ATTACK_ORDERED, ATTACK_STARTED, ATTACK_TERMINATED, KILLED
+		/* IDLE */ { EState::CHASING, NoTransition, EState::REPLACING, EState::PLACING, EState::PLACED, EState::GOING_BACK, NoTransition, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* CHASING */ { NoTransition, EState::IDLE, NoTransition, EState::PLACING, NoTransition, EState::GOING_BACK, NoTransition, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* REPLACING */ { EState::CHASING, NoTransition, NoTransition, EState::PLACING, NoTransition, EState::GOING_BACK, NoTransition, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* PLACING */ { EState::CHASING, NoTransition, EState::REPLACING, NoTransition, EState::PLACED, EState::GOING_BACK, NoTransition, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* PLACED */ { EState::CHASING, NoTransition, EState::REPLACING, EState::PLACING, NoTransition, EState::GOING_BACK, NoTransition, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* GOING_BACK */ { NoTransition, NoTransition, NoTransition, EState::PLACING, NoTransition, NoTransition, EState::IDLE, EState::ATTACK, NoTransition, NoTransition, EState::DEAD },
+		/* ATTACK */ { NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, EState::ATTACKING, EState::IDLE, EState::DEAD },
+		/* ATTACKING */ { NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, EState::IDLE, EState::DEAD },
+		/* DEAD */ { NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition, NoTransition },
+	};
+}
 
 AAIC_Enemy::AAIC_Enemy(const FObjectInitializer& ObjectInitializer) :
 	Super(ObjectInitializer)
@@ -33,8 +57,14 @@ void AAIC_Enemy::BeginPlay()
 	Super::BeginPlay();
 	RunBehaviorTree(btree);
 	behaviorTreeComponent->StartTree(*btree);
-	
-	blackboard->SetValueAsObject("PlayerActor", UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+	bbKeys = FEnemyBlackboardKeys::Get(*blackboard);
+	INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+	blackboard->SetValue<UBlackboardKeyType_Object>(bbKeys.playerActor, UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+
+	movingState = (EEnemyMovingState)blackboard->GetValue<UBlackboardKeyType_Enum>(bbKeys.movingState);
+	stateEnterTime = GetWorld()->GetTimeSeconds();
+	blackboard->RegisterObserver(bbKeys.movingState, this, FOnBlackboardChangeNotification::CreateUObject(this, &AAIC_Enemy::OnMovingStateChanged));
 
 	FindAIEnemyManager();
 
@@ -42,18 +72,15 @@ void AAIC_Enemy::BeginPlay()
 
 void AAIC_Enemy::FindAIEnemyManager()
 {
-	for (TActorIterator<AAIEnemyManager> ActorItr(GetWorld()); ActorItr; ++ActorItr)
+	UEnemyAISubsystem* subsystem = GetWorld()->GetSubsystem<UEnemyAISubsystem>();
+	if (subsystem && subsystem->GetManager())
 	{
-		AAIEnemyManager* aiEnemyManagerCast = Cast<AAIEnemyManager>(*ActorItr);
-		if (aiEnemyManagerCast)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Enemy Manager found!"));
-			aiEnemyManager = aiEnemyManagerCast;
-			aiEnemyManager->AddEnemy(this);
-			return;
-		}
+		UE_LOG(LogGladiatorAI, Verbose, TEXT("Enemy Manager found!"));
+		aiEnemyManager = subsystem->GetManager();
+		aiEnemyManager->AddEnemy(this);
+		return;
 	}
-	UE_LOG(LogTemp, Warning, TEXT("Enemy Manager not found!"));
+	UE_LOG(LogGladiatorAI, Warning, TEXT("Enemy Manager not found!"));
 }
 
 void AAIC_Enemy::OnPossess(APawn* const pawn)
@@ -66,17 +93,103 @@ void AAIC_Enemy::Tick(float deltaTime)
 	Super::Tick(deltaTime);
 }
 
-void AAIC_Enemy::LaunchAttack()
+bool AAIC_Enemy::LaunchAttack()
 {
-	blackboard->SetValueAsEnum("MovingState", 6);
+	GLADIATOR_SCOPE(STAT_GladiatorLaunchAttack);
+
+	return HandleEvent(EEnemyAIEvent::ATTACK_ORDERED);
 }
 
 void AAIC_Enemy::AttackTerminated()
 {
-	blackboard->SetValueAsEnum("MovingState", 0);
-	aiEnemyManager->AttackTerminated();
+	HandleEvent(EEnemyAIEvent::ATTACK_TERMINATED);
 }
 
+bool AAIC_Enemy::HandleEvent(EEnemyAIEvent event)
+{
+	EEnemyMovingState newState = transitionTable[(uint8)movingState][(uint8)event];
+	if (newState == NoTransition || newState == movingState)
+		return false;
+
+	ApplyMovingState(newState);
+	GLADIATOR_AI_EVENT(this, "Moving state", (float)newState);
+
+	INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+
+	// The observer finds the cached state already up to date and does nothing
+	blackboard->SetValue<UBlackboardKeyType_Enum>(bbKeys.movingState, (uint8)newState);
+
+	return true;
+}
+
+void AAIC_Enemy::ApplyMovingState(EEnemyMovingState newState)
+{
+	EEnemyMovingState oldState = movingState;
+
+	float time = GetWorld()->GetTimeSeconds();
+	stateTimes[(uint8)oldState] += time - stateEnterTime;
+	stateEnterTime = time;
+
+	movingState = newState;
+
+	// Leaving an attack by any path gives the turn back to the manager
+	if (IsAttackState(oldState) && !IsAttackState(newState) && aiEnemyManager)
+		aiEnemyManager->AttackTerminated(this);
+}
+
+EBlackboardNotificationResult AAIC_Enemy::OnMovingStateChanged(const UBlackboardComponent& blackboardComp, FBlackboard::FKey key)
+{
+	// Catches writes made outside of HandleEvent, from blueprints for instance
+	EEnemyMovingState newState = (EEnemyMovingState)blackboardComp.GetValue<UBlackboardKeyType_Enum>(key);
+	if (newState != movingState && newState < EEnemyMovingState::COUNT)
+		ApplyMovingState(newState);
+
+	return EBlackboardNotificationResult::ContinueObserving;
+}
+
+float AAIC_Enemy::GetTimeInState(EEnemyMovingState state) const
+{
+	float time = stateTimes[(uint8)state];
+	if (state == movingState)
+		time += GetWorld()->GetTimeSeconds() - stateEnterTime;
+
+	return time;
+}
+
+float AAIC_Enemy::GetPlayerDistance() const
+{
+	if (aiEnemyManager && snapshotIndex != INDEX_NONE)
+		return aiEnemyManager->GetPlayerDistance(snapshotIndex);
+
+	return blackboard->GetValue<UBlackboardKeyType_Float>(bbKeys.distance);
+}
+
+void AAIC_Enemy::Sleep()
+{
+	StopMovement();
+	behaviorTreeComponent->StopTree(EBTStopMode::Safe);
+	SetActorTickEnabled(false);
+}
+
+void AAIC_Enemy::Wake()
+{
+	SetActorTickEnabled(true);
+
+	movingState = EEnemyMovingState::IDLE;
+	stateEnterTime = GetWorld()->GetTimeSeconds();
+	FMemory::Memzero(stateTimes);
+	evaluationAllowed = true;
+	lastAttackTime = -1.f;
+
+	INC_DWORD_STAT_BY(STAT_GladiatorBlackboardWrites, 3);
+	blackboard->SetValue<UBlackboardKeyType_Enum>(bbKeys.movingState, (uint8)movingState);
+	blackboard->SetValue<UBlackboardKeyType_Float>(bbKeys.distance, 0.f);
+	blackboard->ClearValue(bbKeys.currentTarget);
+
+	behaviorTreeComponent->StartTree(*btree);
+
+	FindAIEnemyManager();
+}
 
 UBlackboardComponent* AAIC_Enemy::GetBB() const
 {
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "EnemyBlackboardKeys.h"
+#include "EnemyMovingState.h"
+#include "EnemyRegistry.h"
 #include "AIC_Enemy.generated.h"
 
 /**
@@ -23,15 +26,49 @@ public :
 	virtual void OnPossess(APawn* const pawn);
 
 	class UBlackboardComponent* GetBB() const;
+	const FEnemyBlackboardKeys& GetBBKeys() const { return bbKeys; }
 
 	class AAIEnemyManager* aiEnemyManager;
 
 	void FindAIEnemyManager();
-	void LaunchAttack();
+	/** Returns false if the enemy cannot attack from its current state */
+	bool LaunchAttack();
+
+	/** Simulation time of the last attack order this enemy followed, negative if none */
+	float GetLastAttackTime() const { return lastAttackTime; }
+	void SetLastAttackTime(float time) { lastAttackTime = time; }
 
 	UFUNCTION(BlueprintCallable)
 	void AttackTerminated();
 
+	EEnemyMovingState GetMovingState() const { return movingState; }
+
+	/** Runs the event through the transition table, returns true if the state changed */
+	bool HandleEvent(EEnemyAIEvent event);
+
+	/** Total time spent in a state, the current one included */
+	float GetTimeInState(EEnemyMovingState state) const;
+
+	/** False when the manager pushed this frame's expensive checks to a later frame */
+	bool IsEvaluationAllowed() const { return evaluationAllowed; }
+	void SetEvaluationAllowed(bool allowed) { evaluationAllowed = allowed; }
+
+	FEnemyHandle GetRegistryHandle() const { return registryHandle; }
+	void SetRegistryHandle(FEnemyHandle handle) { registryHandle = handle; }
+
+	/** Index in the manager's snapshot, INDEX_NONE until the manager saw the pawn */
+	int32 GetSnapshotIndex() const { return snapshotIndex; }
+	void SetSnapshotIndex(int32 index) { snapshotIndex = index; }
+
+	/** This frame's distance to the player from the manager, the Distance key without one */
+	float GetPlayerDistance() const;
+
+	/** Stops the tree while the pawn waits in the enemy pool */
+	void Sleep();
+
+	/** Starts over from a fresh blackboard when the pawn leaves the pool */
+	void Wake();
+
 private :
 
 	UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category = AI, meta = (AllowPrivateAccess = "true"))
@@ -42,4 +79,21 @@ private :
 
 	class UBlackboardComponent* blackboard;
 
+	FEnemyBlackboardKeys bbKeys;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = AI, meta = (AllowPrivateAccess = "true"))
+	EEnemyMovingState movingState = EEnemyMovingState::IDLE;
+
+	float stateEnterTime = 0.f;
+	float stateTimes[(uint8)EEnemyMovingState::COUNT] = {};
+
+	bool evaluationAllowed = true;
+	int32 snapshotIndex = INDEX_NONE;
+	FEnemyHandle registryHandle;
+	float lastAttackTime = -1.f;
+
+	void ApplyMovingState(EEnemyMovingState newState);
+
+	EBlackboardNotificationResult OnMovingStateChanged(const UBlackboardComponent& blackboardComp, FBlackboard::FKey key);
+
 };
@@ -2,140 +2,457 @@
 
 
 #include "AIEnemyManager.h"
+#include "GladiatorGame.h"
+#include "AIEventLog.h"
+#include "GladiatorStats.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+#include "BrainComponent.h"
+#include "EnemyCharacter.h"
+#include "Camera/PlayerCameraManager.h"
+#include "EnemyAISubsystem.h"
 
 // Sets default values
 AAIEnemyManager::AAIEnemyManager()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+
+	attackerPolicies = CreateAttackerPolicies();
 }
 
 // Called when the game starts or when spawned
 void AAIEnemyManager::BeginPlay()
 {
 	Super::BeginPlay();
-	LaunchAttackDelay();
+	snapshot.grid.SetCellSize(spatialCellSize);
+	encirclement.Configure((safePlayerDistanceMin + safePlayerDistanceMax) * 0.5f, slotSpacing);
+	nextTokenTime = attackDelay;
+}
+
+void AAIEnemyManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before any BeginPlay, enemies placed in the level find the manager in theirs
+	if (UEnemyAISubsystem* subsystem = GetWorld()->GetSubsystem<UEnemyAISubsystem>())
+		subsystem->RegisterManager(this);
+}
+
+void AAIEnemyManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyAISubsystem* subsystem = GetWorld()->GetSubsystem<UEnemyAISubsystem>())
+		subsystem->UnregisterManager(this);
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void AAIEnemyManager::GetAllEnemyInRadius(TArray<int>& indexs)
+void AAIEnemyManager::GatherAttackCandidates()
 {
-	for (int i = 0; i < enemies.Num(); i++)
+	attackCandidates.Reset();
+
+	for (AAIC_Enemy* enemy : readyEnemies)
 	{
-		if (enemies[i]->GetBlackboardComponent()->GetValueAsFloat("Distance") < safePlayerDistanceMax)
-			indexs.Add(i);
+		const APawn* pawn = enemy->GetPawn();
+		if (!pawn || enemy->GetSnapshotIndex() == INDEX_NONE)
+			continue;
+
+		const float distance = enemy->GetPlayerDistance();
+		if (distance > safePlayerDistanceMax)
+			continue;
+
+		attackCandidates.Add({ enemy, enemy->GetSnapshotIndex(), distance, pawn->GetActorLocation(), enemy->GetLastAttackTime() });
 	}
 }
 
-int AAIEnemyManager::RandomEnemy()
+AAIC_Enemy* AAIEnemyManager::SelectAttacker()
 {
-	TArray<int> indexs;
-	GetAllEnemyInRadius(indexs);
+	GLADIATOR_SCOPE(STAT_GladiatorSelectAttacker);
+
+	const uint64 startCycles = FPlatformTime::Cycles64();
+
+	GatherAttackCandidates();
+
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	FAttackerSelectionContext context;
+	context.candidates = attackCandidates;
+	const AAIC_Enemy* lastAttackerController = enemies.Get(lastAttacker);
+	context.lastAttacker = lastAttackerController;
+	context.lastAttackerOrder = lastAttackerController ? lastAttackerController->GetSnapshotIndex() : INDEX_NONE;
+	context.time = simulationTime;
+	context.maxDistance = safePlayerDistanceMax;
+	context.playerLocation = player ? player->GetActorLocation() : FVector::ZeroVector;
+	context.playerForward = player ? player->GetActorForwardVector() : FVector::ForwardVector;
 
-	if (indexs.Num() == 0)
-		return -1;
+	const int32 selected = attackerPolicies[(int32)attackerPolicy]->Select(context);
 
-	return FMath::FRandRange(0, indexs.Num());
+	lastSelectionMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - startCycles);
+
+	return selected == INDEX_NONE ? nullptr : attackCandidates[selected].enemy;
+}
+
+void AAIEnemyManager::QueueForAttack(AAIC_Enemy* enemyController, float readyTime)
+{
+	attackReadiness.HeapPush({ readyTime, enemyController->GetRegistryHandle() });
 }
 
-int AAIEnemyManager::ClosestEnemy()
+void AAIEnemyManager::ServiceAttackTokens()
 {
-	int index = -1;
-	float minDistance = 999999.f;
+	const float time = simulationTime;
+	if (attackers.Num() >= attackTokens || time < nextTokenTime)
+		return;
 
-	for (int i = 0; i < enemies.Num(); i++)
+	// Cooldowns over, join the enemies the policy picks from
+	while (attackReadiness.Num() > 0 && attackReadiness.HeapTop().readyTime <= time)
 	{
-		float distance = enemies[i]->GetBlackboardComponent()->GetValueAsFloat("Distance");
-		if (minDistance >= distance)
+		FAttackReadiness entry;
+		attackReadiness.HeapPop(entry, false);
+
+		// Enemies removed since they were queued no longer resolve
+		if (AAIC_Enemy* enemy = enemies.Get(entry.enemy))
+			readyEnemies.Add(enemy);
+	}
+
+	while (attackers.Num() < attackTokens)
+	{
+		AAIC_Enemy* attacker = SelectAttacker();
+
+		UE_LOG(LogGladiatorAI, Verbose, TEXT("Attacker = %s, selection took %f ms"), attacker ? *attacker->GetName() : TEXT("None"), lastSelectionMs);
+		GLADIATOR_AI_EVENT(attacker, "Attacker selected", lastSelectionMs);
+
+		// Nobody in range, look again after a delay like after an attack
+		if (!attacker)
+		{
+			nextTokenTime = time + attackDelay;
+			return;
+		}
+
+		readyEnemies.RemoveSwap(attacker);
+
+		if (!attacker->LaunchAttack())
 		{
-			index = i;
-			minDistance = distance;
+			QueueForAttack(attacker, time + attackerCooldown);
+			continue;
 		}
+
+		attacker->SetLastAttackTime(time);
+
+		attackers.Add(attacker);
+		lastAttacker = attacker->GetRegistryHandle();
+
+		// Tokens are handed out one per delay, a wave does not all swing at once
+		nextTokenTime = time + attackDelay;
+		return;
 	}
+}
+
+void AAIEnemyManager::AttackTerminated(AAIC_Enemy* enemyController)
+{
+	// Attacks the manager did not order, from a blackboard write for instance, hold no token
+	if (attackers.RemoveSwap(enemyController) == 0)
+		return;
 
-	if (minDistance > safePlayerDistanceMax)
-		return -1;
+	const float time = simulationTime;
+	nextTokenTime = FMath::Max(nextTokenTime, time + attackDelay);
 
-	return index;
+	if (enemyController->GetMovingState() != EEnemyMovingState::DEAD)
+		QueueForAttack(enemyController, time + attackerCooldown);
 }
 
-int AAIEnemyManager::LastEnemy()
+void AAIEnemyManager::AddEnemy(AAIC_Enemy* enemyController)
 {
-	
-	if (lastEnemyIndex == -1 || lastEnemyIndex >= enemies.Num() || enemies[lastEnemyIndex]->GetBlackboardComponent()->GetValueAsFloat("Distance") > safePlayerDistanceMax)
-		return -1;
+	enemyController->SetRegistryHandle(enemies.Add(enemyController));
+	const FEnemyBlackboardKeys& keys = enemyController->GetBBKeys();
+	INC_DWORD_STAT_BY(STAT_GladiatorBlackboardWrites, 3);
+	enemyController->GetBB()->SetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMin, safePlayerDistanceMin);
+	enemyController->GetBB()->SetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMax, safePlayerDistanceMax);
+
+	// GetPlayerDistance reads this key until the next snapshot, a stale 0 would send the enemy TOO_CLOSE
+	const APawn* pawn = enemyController->GetPawn();
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	const float distance = pawn && player ? FVector::Dist(pawn->GetActorLocation(), player->GetActorLocation()) : MAX_flt;
+	enemyController->GetBB()->SetValue<UBlackboardKeyType_Float>(keys.distance, distance);
 
-	return lastEnemyIndex;
+	QueueForAttack(enemyController, simulationTime);
+
+	// The tree reads the evaluation budget handed out in Tick, make it run after
+	if (UBrainComponent* brain = enemyController->GetBrainComponent())
+		brain->PrimaryComponentTick.AddPrerequisite(this, PrimaryActorTick);
 }
 
-void AAIEnemyManager::LaunchAttackDelay()
+void AAIEnemyManager::DeleteEnemy(AAIC_Enemy* enemyController)
 {
-	FTimerHandle outHandleTime; 
-	GetWorldTimerManager().SetTimer(outHandleTime, this, &AAIEnemyManager::LaunchAttack, attackDelay, false);
+	if (!enemies.Remove(enemyController->GetRegistryHandle()))
+		return;
+
+	// Its readiness entry and lastAttacker stop resolving with the handle
+	AttackTerminated(enemyController);
+	readyEnemies.RemoveSwap(enemyController);
+	enemyController->aiEnemyManager = nullptr;
+
+	encirclement.Release(enemyController);
+	enemyController->SetEvaluationAllowed(true);
+	enemyController->SetSnapshotIndex(INDEX_NONE);
+	enemyController->SetRegistryHandle(FEnemyHandle());
 }
 
-void AAIEnemyManager::LaunchAttack()
+void AAIEnemyManager::UpdateSnapshot()
 {
-	if (enemies.Num() == 0)
+	snapshot.Reset(enemies.Num());
+
+	for (AAIC_Enemy* enemy : enemies)
 	{
-		LaunchAttackDelay();
+		const ACharacter* character = Cast<ACharacter>(enemy->GetPawn());
+		if (!character)
+		{
+			enemy->SetSnapshotIndex(INDEX_NONE);
+			continue;
+		}
+
+		enemy->SetSnapshotIndex(snapshot.Num());
+
+		const UCapsuleComponent* capsule = character->GetCapsuleComponent();
+		snapshot.Add(character, character->GetActorLocation(), capsule->GetScaledCapsuleRadius(), capsule->GetScaledCapsuleHalfHeight(),
+			enemy->GetMovingState() == EEnemyMovingState::PLACED);
+	}
+
+	snapshot.Finalize();
+
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!player)
+	{
+		snapshot.distances.Init(MAX_flt, snapshot.Num());
 		return;
 	}
 
-	int rand = FMath::RandRange(0, 2);
-	int id = -1;
+	snapshot.ComputeDistances(player->GetActorLocation());
 
-	switch (rand)
+	// Kept for the tree asset and blueprints, code reads GetPlayerDistance
+	for (const AAIC_Enemy* enemy : enemies)
 	{
-	case 0:
-		id = ClosestEnemy();
-		break;
-	case 1:
-		id = RandomEnemy();
-		break;
-	case 2:
-		id = LastEnemy();
-		break;
+		const int32 index = enemy->GetSnapshotIndex();
+		if (index == INDEX_NONE)
+			continue;
+
+		UBlackboardComponent* blackboard = enemy->GetBB();
+		const FEnemyBlackboardKeys& keys = enemy->GetBBKeys();
+		if (FMath::Abs(blackboard->GetValue<UBlackboardKeyType_Float>(keys.distance) - snapshot.distances[index]) > distanceKeyTolerance)
+		{
+			INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+			blackboard->SetValue<UBlackboardKeyType_Float>(keys.distance, snapshot.distances[index]);
+		}
 	}
+}
 
-	FString name("NoName");
-	if (id != -1)
-		enemies[id]->GetName(name);
+bool AAIEnemyManager::IsPlacedEnemyInSphere(const FVector& center, float radius, const APawn* ignoredPawn) const
+{
+	return snapshot.IsPlacedEnemyInSphere(center, radius, ignoredPawn);
+}
 
-	UE_LOG(LogTemp, Warning, TEXT("Id = %i, EnemyName = %s"), id, *name);
+bool AAIEnemyManager::IsLineOfFireBlocked(const FVector& start, const FVector& end, const APawn* ignoredPawn) const
+{
+	if (snapshot.IsSegmentBlockedByPlaced(start, end, ignoredPawn))
+		return true;
 
-	if (id == -1)
-	{
-		LaunchAttackDelay();
+	if (!lineOfFireChecksStatic)
+		return false;
+
+	GLADIATOR_COUNT_PHYSICS_QUERIES(1);
+	return GetWorld()->LineTraceTestByObjectType(start, end, FCollisionObjectQueryParams::AllStaticObjects);
+}
+
+FPlacementResult AAIEnemyManager::SolvePlacement(FPlacementRequest request)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorPlacementSolve);
+
+	request.candidateCount = placementCandidates;
+	return placementSolver.Solve(request, snapshot, GetWorld());
+}
+
+bool AAIEnemyManager::GetSlotLocation(const AAIC_Enemy* enemyController, FVector& location) const
+{
+	const int32 slot = encirclement.GetSlot(enemyController);
+	if (slot == INDEX_NONE)
+		return false;
+
+	location = encirclement.GetSlotLocation(slot);
+	return true;
+}
+
+static bool wantsSlot(EEnemyMovingState state)
+{
+	return state == EEnemyMovingState::IDLE || state == EEnemyMovingState::REPLACING ||
+		state == EEnemyMovingState::PLACING || state == EEnemyMovingState::PLACED;
+}
+
+void AAIEnemyManager::UpdateEncirclement()
+{
+	GLADIATOR_SCOPE(STAT_GladiatorEncirclement);
+
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	if (!player || enemies.Num() == 0)
 		return;
+
+	// Any enemy's pawn will do as the nav agent, one may have lost its pawn without being deleted
+	const APawn* navAgent = nullptr;
+	for (const AAIC_Enemy* enemy : enemies)
+	{
+		navAgent = enemy->GetPawn();
+		if (navAgent)
+			break;
 	}
 
+	if (!navAgent)
+		return;
+
+	const bool ringMoved = encirclement.UpdateAnchor(player->GetActorLocation(), slotTolerance, navAgent, GetWorld());
+
+	for (AAIC_Enemy* enemy : enemies)
+	{
+		const APawn* pawn = enemy->GetPawn();
+		if (!pawn)
+			continue;
 
-	enemies[id]->LaunchAttack();
-	lastEnemyIndex = id;
+		const EEnemyMovingState state = enemy->GetMovingState();
+		if (!wantsSlot(state))
+		{
+			encirclement.Release(enemy);
+			continue;
+		}
+
+		int32 slot = encirclement.GetSlot(enemy);
+		const bool newSlot = slot == INDEX_NONE;
+		if (newSlot)
+			slot = encirclement.Assign(enemy, pawn->GetActorLocation());
+
+		// Nothing changed for this enemy, or no free slot and the placement solver takes over
+		if (slot == INDEX_NONE || (!newSlot && !ringMoved))
+			continue;
+
+		const FVector& target = encirclement.GetSlotLocation(slot);
+		INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+		enemy->GetBB()->SetValue<UBlackboardKeyType_Vector>(enemy->GetBBKeys().currentTarget, target);
+
+		// Already walking to or standing on another place, send it to the slot
+		if ((state == EEnemyMovingState::PLACING || state == EEnemyMovingState::PLACED) &&
+			FVector::DistSquared2D(pawn->GetActorLocation(), target) > slotTolerance * slotTolerance)
+		{
+			enemy->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
+		}
+	}
 }
 
-void AAIEnemyManager::AttackTerminated()
+void AAIEnemyManager::ScheduleEvaluations()
 {
-	LaunchAttackDelay();
+	budgetScheduler.BeginFrame(aiBudgetMs);
+	budgetStats = budgetScheduler.stats;
+
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	const FVector playerLocation = player ? player->GetActorLocation() : FVector::ZeroVector;
+	const float fullRateDistanceSquared = fullRateDistance * fullRateDistance;
+
+	// The attacker and the enemies close to the player react every frame
+	int32 forced = 0;
+	for (AAIC_Enemy* enemy : enemies)
+	{
+		const APawn* pawn = enemy->GetPawn();
+		const bool always = !player || !pawn || IsAttackState(enemy->GetMovingState()) ||
+			FVector::DistSquared(pawn->GetActorLocation(), playerLocation) <= fullRateDistanceSquared;
+
+		enemy->SetEvaluationAllowed(always);
+		forced += always;
+	}
+
+	const int32 count = enemies.Num();
+	int32 slots = budgetScheduler.GetSlots(forced);
+	int32 visited = 0;
+
+	// The others share what is left in turns
+	for (; visited < count && slots > 0; visited++)
+	{
+		AAIC_Enemy* enemy = enemies[(budgetScheduler.cursor + visited) % count];
+		if (enemy->IsEvaluationAllowed())
+			continue;
+
+		enemy->SetEvaluationAllowed(true);
+		slots--;
+	}
+
+	budgetScheduler.cursor = count > 0 ? (budgetScheduler.cursor + visited) % count : 0;
+
+	int32 deferred = 0;
+	for (const AAIC_Enemy* enemy : enemies)
+		deferred += !enemy->IsEvaluationAllowed();
+
+	budgetScheduler.AddDeferred(deferred);
 }
 
-void AAIEnemyManager::AddEnemy(AAIC_Enemy* enemyController)
+void AAIEnemyManager::UpdateSignificance()
 {
-	enemies.Add(enemyController);
-	enemyController->GetBlackboardComponent()->SetValueAsFloat("safePlayerDistanceMin", safePlayerDistanceMin);
-	enemyController->GetBlackboardComponent()->SetValueAsFloat("safePlayerDistanceMax", safePlayerDistanceMax);
+	const APawn* player = UGameplayStatics::GetPlayerPawn(this, 0);
+	const APlayerCameraManager* camera = UGameplayStatics::GetPlayerCameraManager(this, 0);
+	if (!player || !camera)
+		return;
+
+	const FVector playerLocation = player->GetActorLocation();
+	const FVector cameraLocation = camera->GetCameraLocation();
+	const float tanHalfFov = FMath::Tan(FMath::DegreesToRadians(camera->GetFOVAngle() * 0.5f));
+
+	for (AAIC_Enemy* enemy : enemies)
+	{
+		AEnemyCharacter* character = Cast<AEnemyCharacter>(enemy->GetPawn());
+		if (!character)
+			continue;
+
+		const FVector location = character->GetActorLocation();
+		const float distance = FVector::Dist(location, playerLocation);
+		const float screenSize = character->GetCapsuleComponent()->GetScaledCapsuleRadius() /
+			FMath::Max(FVector::Dist(location, cameraLocation) * tanHalfFov, 1.f);
+
+		EEnemySignificance significance = EEnemySignificance::LOW;
+		if (IsAttackState(enemy->GetMovingState()) || distance <= significanceNearDistance)
+			significance = EEnemySignificance::HIGH;
+		else if (distance <= significanceFarDistance && screenSize >= significanceMinScreenSize && character->WasRecentlyRendered(0.2f))
+			significance = EEnemySignificance::MEDIUM;
+
+		// Only a change of bucket touches the components
+		if (significance == character->GetSignificance())
+			continue;
+
+		float tickInterval = 0.f;
+		if (significance == EEnemySignificance::MEDIUM)
+			tickInterval = mediumSignificanceTickInterval;
+		else if (significance == EEnemySignificance::LOW)
+			tickInterval = lowSignificanceTickInterval;
+
+		character->ApplySignificance(significance, tickInterval);
+	}
 }
 
-void AAIEnemyManager::DeleteEnemy(AAIC_Enemy* enemyController)
+void AAIEnemyManager::StepSimulation(float stepSeconds)
 {
-	enemies.Remove(enemyController);
+	GLADIATOR_SCOPE(STAT_GladiatorManagerStep);
+
+	simulationTime += stepSeconds;
+
+	UpdateSnapshot();
+	UpdateEncirclement();
+	ServiceAttackTokens();
 }
 
 // Called every frame
 void AAIEnemyManager::Tick(float DeltaTime)
 {
+	GLADIATOR_SCOPE(STAT_GladiatorManagerTick);
+
 	Super::Tick(DeltaTime);
+
+	// Both follow the rendered frame, the budget is per frame and significance depends on the camera
+	ScheduleEvaluations();
+	UpdateSignificance();
 }
 
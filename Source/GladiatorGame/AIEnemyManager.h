@@ -3,27 +3,68 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "EnemySnapshot.h"
+#include "PlacementSolver.h"
+#include "EncirclementPlanner.h"
+#include "AIBudgetScheduler.h"
+#include "AttackerPolicy.h"
+#include "EnemyRegistry.h"
 #include "AIEnemyManager.generated.h"
 
 class AAIC_Enemy;
 
+/** Entry of the attack readiness heap, the enemy may attack again from readyTime */
+struct FAttackReadiness
+{
+	float readyTime;
+	FEnemyHandle enemy;
+
+	bool operator<(const FAttackReadiness& other) const { return readyTime < other.readyTime; }
+};
+
 UCLASS()
 class GLADIATORGAME_API AAIEnemyManager : public AActor
 {
 	GENERATED_BODY()
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = Settings, meta = (AllowPrivateAccess = "true"))
-	TArray<AAIC_Enemy*> enemies;
+	UPROPERTY(VisibleAnywhere, Category = Settings)
+	FEnemyRegistry enemies;
 	
-	int lastEnemyIndex = -1;
+	FEnemyHandle lastAttacker;
+
+	FEnemySnapshot snapshot;
+	FPlacementSolver placementSolver;
+	FEncirclementPlanner encirclement;
+	FAIBudgetScheduler budgetScheduler;
+
+	void UpdateSnapshot();
+	void UpdateEncirclement();
+	void ScheduleEvaluations();
+	void UpdateSignificance();
+
+	/** Filled again on each selection, its memory is kept */
+	TArray<FAttackerCandidate> attackCandidates;
+	TArray<TUniquePtr<IAttackerPolicy>> attackerPolicies;
+
+	/** Enemies on cooldown, a min heap on readyTime */
+	TArray<FAttackReadiness> attackReadiness;
+
+	/** Off cooldown and waiting for a token */
+	TArray<AAIC_Enemy*> readyEnemies;
+
+	/** Enemies holding an attack token */
+	TArray<AAIC_Enemy*> attackers;
+
+	float nextTokenTime = 0.f;
+
+	/** Advanced by StepSimulation only, attack timings do not depend on the frame rate */
+	float simulationTime = 0.f;
 
-	void GetAllEnemyInRadius(TArray<int>& indexs);
-	int RandomEnemy();
-	int ClosestEnemy();
-	int LastEnemy();
+	void GatherAttackCandidates();
+	AAIC_Enemy* SelectAttacker();
 
-	void LaunchAttackDelay();
-	void LaunchAttack();
+	void QueueForAttack(AAIC_Enemy* enemyController, float readyTime);
+	void ServiceAttackTokens();
 
 public:	
 
@@ -33,18 +74,110 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
 		float safePlayerDistanceMax;
 
+	/** Time between two attack tokens handed out, and between a token coming back and the next one */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
 		float attackDelay;
+
+	/** Enemies attacking the player at the same time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		int attackTokens = 1;
+
+	/** Time an enemy waits after its attack before it can be picked again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		float attackerCooldown = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		EAttackerPolicy attackerPolicy = EAttackerPolicy::MIXED;
+
+	/** Time the last attacker selection took */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Settings)
+		float lastSelectionMs = 0.f;
+
+	/** Cell size of the enemy proximity grid, around twice the enemies' wantedRoomRadius works well */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		float spatialCellSize = 200.f;
+
+	/** Candidates scored per placement request */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		int placementCandidates = 16;
+
+	/** Distance kept between two neighbour slots of the ring around the player */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		float slotSpacing = 200.f;
+
+	/** How far the player moves before the ring follows, also how close to its slot an enemy counts as placed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		float slotTolerance = 100.f;
+
+	/** Time in milliseconds the enemies' placement and distance checks may take per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Budget)
+		float aiBudgetMs = 1.f;
+
+	/** Enemies closer to the player than this are evaluated every frame, whatever the budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Budget)
+		float fullRateDistance = 400.f;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Budget)
+		FAIBudgetStats budgetStats;
+
+	/** Enemies closer to the player than this are always at full rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Significance)
+		float significanceNearDistance = 1000.f;
+
+	/** Past this distance, or off screen, or smaller than significanceMinScreenSize, enemies are low significance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Significance)
+		float significanceFarDistance = 3000.f;
+
+	/** Capsule radius over the half width of the view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Significance)
+		float significanceMinScreenSize = 0.02f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Significance)
+		float mediumSignificanceTickInterval = 0.05f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Significance)
+		float lowSignificanceTickInterval = 0.25f;
+
+	/** The Distance blackboard key is only written when it is off by more than this, each write notifies the observers */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		float distanceKeyTolerance = 10.f;
+
+	/** Also trace against static geometry when checking if the way to the player is clear */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+		bool lineOfFireChecksStatic = false;
+
 	// Sets default values for this actor's properties
 	AAIEnemyManager();
 
 	void AddEnemy(AAIC_Enemy* enemyController);
 	void DeleteEnemy(AAIC_Enemy* enemyController);
-	void AttackTerminated();
+	/** One fixed step of the AI, run by UEnemyAISubsystem: distances, ring slots and attack tokens */
+	void StepSimulation(float stepSeconds);
+
+	/** Gives the enemy's token back and puts it on cooldown */
+	void AttackTerminated(AAIC_Enemy* enemyController);
+
+	/** Is a placed enemy other than ignoredPawn touching the sphere, as of this frame's snapshot */
+	bool IsPlacedEnemyInSphere(const FVector& center, float radius, const APawn* ignoredPawn) const;
+
+	/** Is the segment blocked by a placed enemy other than ignoredPawn, or by static geometry if lineOfFireChecksStatic */
+	bool IsLineOfFireBlocked(const FVector& start, const FVector& end, const APawn* ignoredPawn) const;
+
+	/** Scores placementCandidates points at once and returns the best, the candidate count of the request is overridden */
+	FPlacementResult SolvePlacement(FPlacementRequest request);
+
+	/** Location of the ring slot held by the enemy, false if it has none */
+	bool GetSlotLocation(const AAIC_Enemy* enemyController, FVector& location) const;
+
+	FAIBudgetScheduler& GetBudgetScheduler() { return budgetScheduler; }
+
+	float GetPlayerDistance(int32 snapshotIndex) const { return snapshot.distances[snapshotIndex]; }
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AIEventLog.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	struct FAIEvent
+	{
+		uint64 frame;
+		double time;
+		FName source;
+		const TCHAR* what;
+		float value;
+	};
+
+	int32 enabled = 0;
+	FAutoConsoleVariableRef enabledVariable(
+		TEXT("gladiator.AIEventLog"),
+		enabled,
+		TEXT("Records the enemy AI decisions in a ring buffer, 0 to stop"));
+
+	TArray<FAIEvent> events;
+
+	/** Where the next event goes, the oldest one once the buffer is full */
+	int32 head = 0;
+
+	FAutoConsoleCommandWithOutputDevice dumpCommand(
+		TEXT("gladiator.AIEventLog.Dump"),
+		TEXT("Prints the recorded enemy AI decisions, oldest first"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FAIEventLog::Dump));
+
+	FAutoConsoleCommand clearCommand(
+		TEXT("gladiator.AIEventLog.Clear"),
+		TEXT("Forgets the recorded enemy AI decisions"),
+		FConsoleCommandDelegate::CreateStatic(&FAIEventLog::Clear));
+}
+
+bool FAIEventLog::IsEnabled()
+{
+	return enabled != 0;
+}
+
+void FAIEventLog::Record(const UObject* source, const TCHAR* what, float value)
+{
+	check(IsInGameThread());
+
+	const FAIEvent event{ GFrameCounter, FPlatformTime::Seconds(), source ? source->GetFName() : NAME_None, what, value };
+
+	if (events.Num() < Capacity)
+	{
+		events.Add(event);
+		return;
+	}
+
+	events[head] = event;
+	head = (head + 1) % Capacity;
+}
+
+void FAIEventLog::Dump(FOutputDevice& output)
+{
+	output.Logf(TEXT("%d AI events"), events.Num());
+
+	for (int32 i = 0; i < events.Num(); i++)
+	{
+		const FAIEvent& event = events[(head + i) % events.Num()];
+		output.Logf(TEXT("[%llu] %.3f %s %s %f"), event.frame, event.time, *event.source.ToString(), event.what, event.value);
+	}
+}
+
+void FAIEventLog::Clear()
+{
+	events.Reset();
+	head = 0;
+}
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Last AI decisions kept in a fixed ring buffer, recorded without formatting and printed on demand.
+ * Off by default, gladiator.AIEventLog 1 turns it on and gladiator.AIEventLog.Dump prints it.
+ */
+class GLADIATORGAME_API FAIEventLog
+{
+public:
+	static constexpr int32 Capacity = 1024;
+
+	static bool IsEnabled();
+
+	/** what must be a literal, only the pointer is kept */
+	static void Record(const UObject* source, const TCHAR* what, float value);
+
+	static void Dump(FOutputDevice& output);
+	static void Clear();
+};
+
+#if UE_BUILD_SHIPPING
+#define GLADIATOR_AI_EVENT(Source, What, Value)
+#else
+#define GLADIATOR_AI_EVENT(Source, What, Value) \
+	do { if (FAIEventLog::IsEnabled()) FAIEventLog::Record(Source, TEXT(What), Value); } while (0)
+#endif
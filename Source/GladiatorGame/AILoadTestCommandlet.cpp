@@ -0,0 +1,233 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AILoadTestCommandlet.h"
+#include "AIController.h"
+#include "AIEnemyManager.h"
+#include "EnemyAISubsystem.h"
+#include "EnemyCharacter.h"
+#include "EnemyPoolSubsystem.h"
+#include "GladiatorStats.h"
+#include "WeaponAttachment.h"
+#include "EngineUtils.h"
+#include "LifeComponent.h"
+#include "NavigationSystem.h"
+#include "PlayerCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAILoadTest, Log, All);
+
+UAILoadTestCommandlet::UAILoadTestCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAILoadTestCommandlet::Main(const FString& Params)
+{
+	FString counts = TEXT("10,50,200,500");
+	FParse::Value(*Params, TEXT("enemies="), counts);
+
+	int32 frames = 1800;
+	FParse::Value(*Params, TEXT("frames="), frames);
+
+	int32 seed = 1;
+	FParse::Value(*Params, TEXT("seed="), seed);
+
+	const FString outputDir = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("AILoadTest");
+
+	TArray<FString> countStrings;
+	counts.ParseIntoArray(countStrings, TEXT(","));
+
+	int32 failures = 0;
+	for (const FString& countString : countStrings)
+	{
+		const int32 enemyCount = FCString::Atoi(*countString);
+		const FString csvPath = outputDir / FString::Printf(TEXT("AILoadTest_%d.csv"), enemyCount);
+
+		if (!RunScenario(enemyCount, frames, seed, csvPath))
+			failures++;
+	}
+
+	return failures;
+}
+
+bool UAILoadTestCommandlet::RunScenario(int32 enemyCount, int32 frames, int32 seed, const FString& csvPath)
+{
+	UE_LOG(LogAILoadTest, Display, TEXT("%d enemies, %d frames, seed %d"), enemyCount, frames, seed);
+
+	// Everything that rolls dice in the AI goes through the global streams
+	FMath::RandInit(seed);
+	FMath::SRandInit(seed);
+	FRandomStream random(seed);
+
+	UGameInstance* gameInstance = NewObject<UGameInstance>(GEngine);
+	gameInstance->AddToRoot();
+	gameInstance->InitializeStandalone();
+
+	FString error;
+	FWorldContext& context = *gameInstance->GetWorldContext();
+	if (GEngine->LoadMap(context, FURL(*mapName), nullptr, error) != EBrowseReturnVal::Success)
+	{
+		UE_LOG(LogAILoadTest, Error, TEXT("Could not load %s: %s"), *mapName, *error);
+		gameInstance->RemoveFromRoot();
+		return false;
+	}
+
+	UWorld* world = context.World();
+
+	// No local player joins a commandlet world, so the player is spawned and driven by hand
+	FTransform playerTransform = FTransform::Identity;
+	for (TActorIterator<APlayerStart> it(world); it; ++it)
+	{
+		playerTransform = it->GetActorTransform();
+		break;
+	}
+
+	UClass* playerPawnClass = playerClass.TryLoadClass<APlayerCharacter>();
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	APlayerCharacter* player = world->SpawnActor<APlayerCharacter>(playerPawnClass ? playerPawnClass : APlayerCharacter::StaticClass(), playerTransform, spawnParams);
+	if (!player)
+	{
+		UE_LOG(LogAILoadTest, Error, TEXT("Could not spawn the player"));
+		GEngine->DestroyWorldContext(world);
+		world->DestroyWorld(false);
+		gameInstance->RemoveFromRoot();
+		return false;
+	}
+
+	// An AI controller counts as local, so the character movement consumes its input
+	AAIController* playerController = world->SpawnActor<AAIController>();
+	playerController->Possess(player);
+
+	// The run measures the AI, not how long the player survives it
+	player->healthComponent->SetLife(MAX_int32 / 2);
+
+	int32 aliveEnemies = 0;
+	for (TActorIterator<AEnemyCharacter> it(world); it; ++it)
+		aliveEnemies++;
+
+	UClass* enemyPawnClass = enemyClass.TryLoadClass<AEnemyCharacter>();
+	if (!enemyPawnClass)
+		UE_LOG(LogAILoadTest, Error, TEXT("Could not load %s"), *enemyClass.ToString());
+
+	// The whole wave is created here, spawning it and the later respawns only wake pooled enemies
+	UEnemyPoolSubsystem* pool = world->GetSubsystem<UEnemyPoolSubsystem>();
+	if (pool && enemyPawnClass)
+	{
+		pool->Prewarm(enemyPawnClass, FMath::Max(enemyCount - aliveEnemies, 0));
+		aliveEnemies += SpawnEnemies(world, enemyPawnClass, player->GetActorLocation(), FMath::Max(enemyCount - aliveEnemies, 0), random);
+	}
+
+	// Compares runs with the weapons held as static meshes or as skeletal meshes
+	UE_LOG(LogAILoadTest, Display, TEXT("%s"), *FGladiatorComponentStats::Gather(world).ToString());
+
+	UEnemyAISubsystem* aiSubsystem = world->GetSubsystem<UEnemyAISubsystem>();
+
+	TArray<FString> lines;
+	lines.Reserve(frames + 1);
+	lines.Add(TEXT("Frame,Enemies,GameThreadMs,AIStepsMs,AIEvaluationMs,DeferredEvaluations,FramesOverBudget,PhysicsQueries,NavProjections,Respawned,NewObjects"));
+
+	const float deltaSeconds = 1.f / FMath::Max(frameRate, 1.f);
+	for (int32 frame = 0; frame < frames; frame++)
+	{
+		const int32 objectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+		// Dead enemies come back as soon as the pool has them again, never as new actors
+		int32 respawned = 0;
+		if (pool && enemyPawnClass)
+		{
+			const int32 missing = FMath::Min(enemyCount - aliveEnemies, pool->GetPooledCount(enemyPawnClass));
+			if (missing > 0)
+				respawned = SpawnEnemies(world, enemyPawnClass, player->GetActorLocation(), missing, random);
+		}
+
+		DriveInput(player, frame, random);
+
+		FGladiatorQueryCounters::physicsQueries.Reset();
+		FGladiatorQueryCounters::navProjections.Reset();
+
+		const double startTime = FPlatformTime::Seconds();
+		world->Tick(LEVELTICK_All, deltaSeconds);
+		const double gameThreadMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+
+		// The engine loop is not running, per-frame caches key on this
+		GFrameCounter++;
+
+		aliveEnemies = 0;
+		for (TActorIterator<AEnemyCharacter> it(world); it; ++it)
+		{
+			if (it->isAlive())
+				aliveEnemies++;
+		}
+
+		const AAIEnemyManager* manager = aiSubsystem ? aiSubsystem->GetManager() : nullptr;
+		const FAIBudgetStats stats = manager ? manager->budgetStats : FAIBudgetStats();
+		const double stepsMs = aiSubsystem ? aiSubsystem->GetLastStepsSeconds() * 1000.0 : 0.0;
+
+		const int32 newObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - objectsBefore;
+
+		lines.Add(FString::Printf(TEXT("%d,%d,%.4f,%.4f,%.4f,%d,%d,%d,%d,%d,%d"), frame, aliveEnemies, gameThreadMs, stepsMs, stats.lastFrameMs, stats.deferredEvaluations, stats.framesOverBudget,
+			FGladiatorQueryCounters::physicsQueries.GetValue(), FGladiatorQueryCounters::navProjections.GetValue(), respawned, newObjects));
+	}
+
+	const bool saved = FFileHelper::SaveStringArrayToFile(lines, *csvPath);
+	if (saved)
+		UE_LOG(LogAILoadTest, Display, TEXT("Wrote %s"), *csvPath);
+	else
+		UE_LOG(LogAILoadTest, Error, TEXT("Could not write %s"), *csvPath);
+
+	GEngine->DestroyWorldContext(world);
+	world->DestroyWorld(false);
+	gameInstance->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return saved;
+}
+
+int32 UAILoadTestCommandlet::SpawnEnemies(UWorld* world, TSubclassOf<AEnemyCharacter> enemyPawnClass, const FVector& center, int32 count, FRandomStream& random)
+{
+	UNavigationSystemV1* navSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(world);
+	UEnemyPoolSubsystem* pool = world->GetSubsystem<UEnemyPoolSubsystem>();
+
+	int32 spawned = 0;
+	for (int32 i = 0; i < count; i++)
+	{
+		FVector location = center + FVector(random.VRand().GetSafeNormal2D() * random.FRandRange(300.f, spawnRadius));
+
+		FNavLocation navLocation;
+		if (navSystem && navSystem->ProjectPointToNavigation(location, navLocation))
+			location = navLocation.Location;
+
+		const FRotator rotation(0.f, (center - location).Rotation().Yaw, 0.f);
+		if (pool->Spawn(enemyPawnClass, FTransform(rotation, location + FVector(0.f, 0.f, 100.f))))
+			spawned++;
+	}
+
+	return spawned;
+}
+
+void UAILoadTestCommandlet::DriveInput(APlayerCharacter* player, int32 frame, const FRandomStream& random)
+{
+	const float time = frame / FMath::Max(frameRate, 1.f);
+
+	// Wide circles with a slow wobble, the phase comes from the seed
+	const float phase = random.GetInitialSeed() * 0.1f;
+	const FVector direction(FMath::Cos(time * 0.5f + phase), FMath::Sin(time * 0.5f + phase) + 0.3f * FMath::Sin(time * 1.7f), 0.f);
+	player->AddMovementInput(direction.GetSafeNormal(), 1.f);
+
+	if (frame % 90 == 0)
+		player->Attack();
+
+	if (frame == 0)
+		player->SetCameraLock();
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AILoadTestCommandlet.generated.h"
+
+class AEnemyCharacter;
+class APlayerCharacter;
+
+/**
+ * Runs the arena headless with a given number of enemies and writes per-frame AI timings and query counts to CSV.
+ * Killed enemies are respawned from the enemy pool, NewObjects shows the objects created each frame.
+ * UE4Editor-Cmd GladiatorGame.uproject -run=AILoadTest -nullrhi [-enemies=10,50,200,500] [-frames=1800] [-seed=1]
+ * Every run loads the map again, with the same seed and the same scripted player input.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UAILoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+	bool RunScenario(int32 enemyCount, int32 frames, int32 seed, const FString& csvPath);
+
+	/** Spawns through the enemy pool, returns how many were spawned */
+	int32 SpawnEnemies(UWorld* world, TSubclassOf<AEnemyCharacter> enemyPawnClass, const FVector& center, int32 count, FRandomStream& random);
+
+	/** Walks the player around in loops and swings every so often, the same way every run */
+	void DriveInput(APlayerCharacter* player, int32 frame, const FRandomStream& random);
+
+public:
+	UAILoadTestCommandlet();
+
+	UPROPERTY(config)
+	FString mapName = TEXT("/Game/Levels/Arena");
+
+	UPROPERTY(config)
+	FSoftClassPath playerClass = FSoftClassPath(TEXT("/Game/Blueprints/Player/PlayerCharacter.PlayerCharacter_C"));
+
+	UPROPERTY(config)
+	FSoftClassPath enemyClass = FSoftClassPath(TEXT("/Game/Blueprints/Enemy/EnemyCharacter.EnemyCharacter_C"));
+
+	/** Enemies are spawned on the navmesh within this distance of the player */
+	UPROPERTY(config)
+	float spawnRadius = 3000.f;
+
+	UPROPERTY(config)
+	float frameRate = 60.f;
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AttackerPolicy.h"
+
+namespace
+{
+	int32 selectClosest(const FAttackerSelectionContext& context)
+	{
+		int32 best = INDEX_NONE;
+		for (int32 i = 0; i < context.candidates.Num(); i++)
+		{
+			if (best == INDEX_NONE || context.candidates[i].distance <= context.candidates[best].distance)
+				best = i;
+		}
+
+		return best;
+	}
+
+	int32 selectRandom(const FAttackerSelectionContext& context)
+	{
+		if (context.candidates.Num() == 0)
+			return INDEX_NONE;
+
+		return FMath::RandHelper(context.candidates.Num());
+	}
+
+	int32 selectLast(const FAttackerSelectionContext& context)
+	{
+		for (int32 i = 0; i < context.candidates.Num(); i++)
+		{
+			if (context.candidates[i].enemy == context.lastAttacker)
+				return i;
+		}
+
+		return INDEX_NONE;
+	}
+
+	class FMixedPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override
+		{
+			switch (FMath::RandRange(0, 2))
+			{
+			case 0:
+				return selectClosest(context);
+			case 1:
+				return selectRandom(context);
+			default:
+				return selectLast(context);
+			}
+		}
+	};
+
+	class FClosestPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override { return selectClosest(context); }
+	};
+
+	class FRandomPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override { return selectRandom(context); }
+	};
+
+	class FLastPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override { return selectLast(context); }
+	};
+
+	class FWeightedRandomPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override
+		{
+			// Weight falls linearly from the player to the edge of the range, never down to zero
+			auto weight = [&context](const FAttackerCandidate& candidate)
+			{
+				return FMath::Max(1.f - candidate.distance / FMath::Max(context.maxDistance, 1.f), 0.1f);
+			};
+
+			float total = 0.f;
+			for (const FAttackerCandidate& candidate : context.candidates)
+				total += weight(candidate);
+
+			float pick = FMath::FRand() * total;
+			for (int32 i = 0; i < context.candidates.Num(); i++)
+			{
+				pick -= weight(context.candidates[i]);
+				if (pick <= 0.f)
+					return i;
+			}
+
+			return context.candidates.Num() - 1;
+		}
+	};
+
+	class FRoundRobinPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override
+		{
+			// The next one after the last attacker in snapshot order, wrapping around to the first
+			int32 next = INDEX_NONE;
+			int32 first = INDEX_NONE;
+
+			for (int32 i = 0; i < context.candidates.Num(); i++)
+			{
+				const int32 order = context.candidates[i].order;
+				if (order > context.lastAttackerOrder && (next == INDEX_NONE || order < context.candidates[next].order))
+					next = i;
+
+				if (first == INDEX_NONE || order < context.candidates[first].order)
+					first = i;
+			}
+
+			return next != INDEX_NONE ? next : first;
+		}
+	};
+
+	class FThreatScorePolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override
+		{
+			int32 best = INDEX_NONE;
+			float bestScore = -MAX_flt;
+
+			for (int32 i = 0; i < context.candidates.Num(); i++)
+			{
+				const FAttackerCandidate& candidate = context.candidates[i];
+
+				const float closeness = 1.f - candidate.distance / FMath::Max(context.maxDistance, 1.f);
+				const float inView = FVector::DotProduct((candidate.location - context.playerLocation).GetSafeNormal2D(), context.playerForward);
+				const float waited = candidate.lastAttackTime < 0.f ? 1.f : FMath::Min((context.time - candidate.lastAttackTime) / 10.f, 1.f);
+
+				// Attacks the player can see coming, from enemies that have not had a turn for a while
+				const float score = closeness + 0.5f * inView + waited;
+				if (score > bestScore)
+				{
+					best = i;
+					bestScore = score;
+				}
+			}
+
+			return best;
+		}
+	};
+
+	class FLeastRecentlyAttackedPolicy : public IAttackerPolicy
+	{
+	public:
+		virtual int32 Select(const FAttackerSelectionContext& context) override
+		{
+			int32 best = INDEX_NONE;
+			for (int32 i = 0; i < context.candidates.Num(); i++)
+			{
+				if (best == INDEX_NONE || context.candidates[i].lastAttackTime < context.candidates[best].lastAttackTime)
+					best = i;
+			}
+
+			return best;
+		}
+	};
+}
+
+TArray<TUniquePtr<IAttackerPolicy>> CreateAttackerPolicies()
+{
+	TArray<TUniquePtr<IAttackerPolicy>> policies;
+	policies.SetNum((int32)EAttackerPolicy::COUNT);
+
+	policies[(int32)EAttackerPolicy::MIXED] = MakeUnique<FMixedPolicy>();
+	policies[(int32)EAttackerPolicy::CLOSEST] = MakeUnique<FClosestPolicy>();
+	policies[(int32)EAttackerPolicy::RANDOM] = MakeUnique<FRandomPolicy>();
+	policies[(int32)EAttackerPolicy::LAST] = MakeUnique<FLastPolicy>();
+	policies[(int32)EAttackerPolicy::WEIGHTED_RANDOM] = MakeUnique<FWeightedRandomPolicy>();
+	policies[(int32)EAttackerPolicy::ROUND_ROBIN] = MakeUnique<FRoundRobinPolicy>();
+	policies[(int32)EAttackerPolicy::THREAT_SCORE] = MakeUnique<FThreatScorePolicy>();
+	policies[(int32)EAttackerPolicy::LEAST_RECENTLY_ATTACKED] = MakeUnique<FLeastRecentlyAttackedPolicy>();
+
+	return policies;
+}
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttackerPolicy.generated.h"
+
+class AAIC_Enemy;
+
+/** How AAIEnemyManager picks the next enemy to attack */
+UENUM(BlueprintType)
+enum class EAttackerPolicy : uint8 {
+	MIXED					UMETA(DisplayName = "Mixed", ToolTip = "Closest, random or last attacker, picked at random each time"),
+	CLOSEST					UMETA(DisplayName = "Closest"),
+	RANDOM					UMETA(DisplayName = "Random"),
+	LAST					UMETA(DisplayName = "Last Attacker"),
+	WEIGHTED_RANDOM			UMETA(DisplayName = "Weighted Random", ToolTip = "Random, closer enemies are more likely"),
+	ROUND_ROBIN				UMETA(DisplayName = "Round Robin"),
+	THREAT_SCORE			UMETA(DisplayName = "Threat Score", ToolTip = "Close enemies in front of the player that waited the longest"),
+	LEAST_RECENTLY_ATTACKED	UMETA(DisplayName = "Least Recently Attacked"),
+	COUNT					UMETA(Hidden)
+};
+
+struct FAttackerCandidate
+{
+	AAIC_Enemy* enemy;
+
+	/** Index of the enemy in the snapshot taken for this selection, only used to compare candidates */
+	int32 order;
+	float distance;
+	FVector location;
+
+	/** Simulation time of the enemy's last attack, negative if it never attacked */
+	float lastAttackTime;
+};
+
+struct FAttackerSelectionContext
+{
+	TArrayView<const FAttackerCandidate> candidates;
+
+	const AAIC_Enemy* lastAttacker;
+
+	/** Snapshot index of the last attacker, INDEX_NONE if there is none */
+	int32 lastAttackerOrder;
+
+	float time;
+	float maxDistance;
+	FVector playerLocation;
+	FVector playerForward;
+};
+
+/**
+ * Picks an attacker among candidates the manager already gathered, in range of the player and off cooldown.
+ * Policies keep no per call allocation, the candidates buffer belongs to the manager.
+ */
+class IAttackerPolicy
+{
+public:
+	virtual ~IAttackerPolicy() {}
+
+	/** Index in context.candidates, INDEX_NONE to skip this turn */
+	virtual int32 Select(const FAttackerSelectionContext& context) = 0;
+};
+
+/** One instance of every policy, indexed by EAttackerPolicy */
+TArray<TUniquePtr<IAttackerPolicy>> CreateAttackerPolicies();
@@ -2,7 +2,8 @@
 
 
 #include "BTD_CheckAttack.h"
-#include "BehaviorTree/BlackboardComponent.h"
+#include "GladiatorStats.h"
+#include "AIC_Enemy.h"
 
 //#include "BehaviorTree/BehaviorTreeComponent.h"
 
@@ -13,7 +14,11 @@ UBTD_CheckAttack::UBTD_CheckAttack(const FObjectInitializer& ObjectInitializer)
 
 bool UBTD_CheckAttack::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	if (OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState") == 6)
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckAttack);
+
+	const AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+
+	if (enemyController->GetMovingState() == EEnemyMovingState::ATTACK)
 		return true;
 
 	return false;
@@ -2,9 +2,11 @@
 
 
 #include "BTD_CheckAttackDistance.h"
+#include "GladiatorStats.h"
 #include "EnemyCharacter.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 
 
 UBTD_CheckAttackDistance::UBTD_CheckAttackDistance(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -14,12 +16,15 @@ UBTD_CheckAttackDistance::UBTD_CheckAttackDistance(const FObjectInitializer& Obj
 
 bool UBTD_CheckAttackDistance::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckAttackDistance);
+
 	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
 
-	float distance = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("Distance");
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCharacter->GetController());
+
+	float distance = enemyController->GetPlayerDistance();
 	if (enemyCharacter->attackDistance >= distance)
 	{
-		AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCharacter->GetController());
 		enemyController->StopMovement();
 
 		return false;
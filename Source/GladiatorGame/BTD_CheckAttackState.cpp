@@ -2,7 +2,8 @@
 
 
 #include "BTD_CheckAttackState.h"
-#include "BehaviorTree/BlackboardComponent.h"
+#include "GladiatorStats.h"
+#include "AIC_Enemy.h"
 
 UBTD_CheckAttackState::UBTD_CheckAttackState(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -11,8 +12,12 @@ UBTD_CheckAttackState::UBTD_CheckAttackState(const FObjectInitializer& ObjectIni
 
 bool UBTD_CheckAttackState::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	int enumId = OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState");
-	if (enumId == 6 || enumId == 7)
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckAttackState);
+
+	const AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+
+	EEnemyMovingState state = enemyController->GetMovingState();
+	if (state == EEnemyMovingState::ATTACK || state == EEnemyMovingState::ATTACKING)
 		return false;
 
 	return true;
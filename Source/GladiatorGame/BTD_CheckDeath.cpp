@@ -2,8 +2,9 @@
 
 
 #include "BTD_CheckDeath.h"
+#include "GladiatorStats.h"
 #include "PlayerCharacter.h"
-#include "BehaviorTree/BlackboardComponent.h"
+#include "AIC_Enemy.h"
 
 UBTD_CheckDeath::UBTD_CheckDeath(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -12,7 +13,11 @@ UBTD_CheckDeath::UBTD_CheckDeath(const FObjectInitializer& ObjectInitializer) :
 
 bool UBTD_CheckDeath::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	if (OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState") == 8)
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckDeath);
+
+	const AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+
+	if (enemyController->GetMovingState() == EEnemyMovingState::DEAD)
 		return false;
 
 	return true;
@@ -2,10 +2,12 @@
 
 
 #include "BTD_CheckMove.h"
+#include "GladiatorStats.h"
 #include "EnemyCharacter.h"
 #include "PlayerCharacter.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 
 UBTD_CheckMove::UBTD_CheckMove(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -14,18 +16,22 @@ UBTD_CheckMove::UBTD_CheckMove(const FObjectInitializer& ObjectInitializer) : Su
 
 bool UBTD_CheckMove::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	if (OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState") != 1)
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckMove);
+
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+	if (enemyController->GetMovingState() != EEnemyMovingState::CHASING)
 		return false;
 
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	const UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const FEnemyBlackboardKeys& keys = enemyController->GetBBKeys();
+
+	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(keys.playerActor));
 	float playerSpeed = FVector::VectorPlaneProject(playerCharacter->GetVelocity(), FVector(0, 0, 1)).Size();
 	
 	if (playerSpeed == 0)
 	{
-		OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 0);
-
-		const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
-		enemyCharacter->GetController()->StopMovement();
+		enemyController->HandleEvent(EEnemyAIEvent::PLAYER_STOPPED);
+		enemyController->StopMovement();
 
 		return false;
 	}
@@ -2,13 +2,16 @@
 
 
 #include "BTD_CheckPlacing.h"
+#include "GladiatorStats.h"
 #include "EnemyCharacter.h"
 #include "PlayerCharacter.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 #include "Components/CapsuleComponent.h"
 #include "DrawDebugHelpers.h"
 #include "BTT_PlaceAroundPlayer.h"
+#include "AIEnemyManager.h"
 
 UBTD_CheckPlacing::UBTD_CheckPlacing(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -17,84 +20,123 @@ UBTD_CheckPlacing::UBTD_CheckPlacing(const FObjectInitializer& ObjectInitializer
 
 bool UBTD_CheckPlacing::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	float safePlayerDistanceMin = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMin");
-	float safePlayerDistanceMax = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMax");
-	int enumId = OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState");
-	if (enumId == 1)
+	GLADIATOR_SCOPE(STAT_GladiatorBTD_CheckPlacing);
+
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+
+	EEnemyMovingState state = enemyController->GetMovingState();
+	if (state == EEnemyMovingState::CHASING)
 		return false;
 
-	const AAIController* cont = OwnerComp.GetAIOwner();
-	APawn* enemyPawn = cont->GetPawn();
+	UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const FEnemyBlackboardKeys& keys = enemyController->GetBBKeys();
+
+	AAIEnemyManager* manager = enemyController->aiEnemyManager;
+
+	// Only the expensive checks below are timed, the cheap calls would pull the learnt cost down
+	FAIBudgetScheduler* budget = manager ? &manager->GetBudgetScheduler() : nullptr;
+
+	// Out of budget this frame, only the cheap state checks run
+	const bool evaluate = enemyController->IsEvaluationAllowed();
+
+	float safePlayerDistanceMin = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMin);
+	float safePlayerDistanceMax = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMax);
+
+	APawn* enemyPawn = enemyController->GetPawn();
 	const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(enemyPawn);
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(keys.playerActor));
 
-	if (enumId != 5 && enumId != 1)
+	if (state != EEnemyMovingState::GOING_BACK)
 	{
 		float playerSpeed = FVector::VectorPlaneProject(playerCharacter->GetVelocity(), FVector(0, 0, 1)).Size();
 
 		if (playerSpeed > 0 && 
-			FVector::Dist(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation()) > safePlayerDistanceMax)
+			FVector::Dist(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation()) > safePlayerDistanceMax &&
+			enemyController->HandleEvent(EEnemyAIEvent::PLAYER_OUT_OF_RANGE))
 		{
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 1);
 			return false;
 		}
 	}
 
 
-	if (enumId == 0) //Idle
+	FVector slotLocation;
+	const bool hasSlot = manager && manager->GetSlotLocation(enemyController, slotLocation);
+
+	if (state == EEnemyMovingState::IDLE && hasSlot)
 	{
-		FVector desiredTarget = ProjectPointOnNavigableLocation(enemyCharacter->GetActorLocation(), enemyPawn);
-		float distance = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("Distance");
-		
-		if (distance < safePlayerDistanceMax && distance > safePlayerDistanceMin)
+		if (FVector::DistSquared2D(enemyCharacter->GetActorLocation(), slotLocation) > FMath::Square(manager->slotTolerance))
 		{
-			if (checkIfPawnIsInSphere(enemyCharacter->wantedRoomRadius, desiredTarget, enemyPawn))
-			{
-				OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 2);
-				return true;
-			}
-		
-			if (checkIfPawnEnemyIsFront(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation(), enemyPawn))
+			enemyController->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
+			return true;
+		}
+
+		INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+		blackboard->SetValue<UBlackboardKeyType_Vector>(keys.currentTarget, slotLocation);
+		enemyController->HandleEvent(EEnemyAIEvent::PLACE_REACHED);
+		return false;
+	}
+	else if (state == EEnemyMovingState::IDLE)
+	{
+		float distance = enemyController->GetPlayerDistance();
+		const bool inRange = distance < safePlayerDistanceMax && distance > safePlayerDistanceMin;
+
+		// Without budget the current spot is not checked, the enemy stays idle until a frame with budget
+		if (inRange && !evaluate)
+			return false;
+
+		if (inRange)
+		{
+			FAIBudgetScope budgetScope(budget);
+
+			FVector desiredTarget = ProjectPointOnNavigableLocation(enemyCharacter->GetActorLocation(), enemyPawn);
+
+			if (checkIfPawnIsInSphere(enemyCharacter->wantedRoomRadius, desiredTarget, enemyPawn) ||
+				checkIfPawnEnemyIsFront(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation(), enemyPawn))
 			{
-				OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 2);
+				enemyController->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
 				return true;
 			}
-		
-		
-			OwnerComp.GetBlackboardComponent()->SetValueAsVector("currentTarget", desiredTarget);
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 4);
+
+			INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+			blackboard->SetValue<UBlackboardKeyType_Vector>(keys.currentTarget, desiredTarget);
+			enemyController->HandleEvent(EEnemyAIEvent::PLACE_REACHED);
 			return false;
 		}
 
-		OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 2);
+		enemyController->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
 		return true;
 	}
-	else if (enumId == 3) //Placing
+	else if (state == EEnemyMovingState::PLACING)
 	{
-		FVector currentTarget = OwnerComp.GetBlackboardComponent()->GetValueAsVector("currentTarget");
+		FVector currentTarget = blackboard->GetValue<UBlackboardKeyType_Vector>(keys.currentTarget);
 
-		if (checkIfPawnIsInSphere(enemyCharacter->wantedRoomRadius, currentTarget, enemyPawn))
+		if (evaluate && !hasSlot)
 		{
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 2);
-			return true;
+			FAIBudgetScope budgetScope(budget);
+
+			if (checkIfPawnIsInSphere(enemyCharacter->wantedRoomRadius, currentTarget, enemyPawn))
+			{
+				enemyController->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
+				return true;
+			}
 		}
 
-		AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
 		if (enemyController->GetMoveStatus() == EPathFollowingStatus::Idle)
-		{
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 4);
-			return false;
-		}
+			enemyController->HandleEvent(EEnemyAIEvent::PLACE_REACHED);
 
 		return false;
 	}
-	else if (enumId == 4) //Placed
+	else if (state == EEnemyMovingState::PLACED)
 	{
-		FVector currentTarget = OwnerComp.GetBlackboardComponent()->GetValueAsVector("currentTarget");
-		
+		// Slots are apart from each other already, the manager moves the enemy when its slot moves
+		if (hasSlot || !evaluate)
+			return false;
+
+		FAIBudgetScope budgetScope(budget);
+
 		if (checkIfPawnEnemyIsFront(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation(), enemyPawn))
 		{
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 2);
+			enemyController->HandleEvent(EEnemyAIEvent::NEEDS_PLACE);
 			return true;
 		}
 				
@@ -106,7 +148,13 @@ bool UBTD_CheckPlacing::CalculateRawConditionValue(UBehaviorTreeComponent& Owner
 
 bool checkIfPawnIsInSphere(float radius, const FVector& center, APawn* ownPawn)
 {
+	const AAIC_Enemy* ownController = Cast<AAIC_Enemy>(ownPawn->GetController());
+	if (ownController && ownController->aiEnemyManager)
+		return ownController->aiEnemyManager->IsPlacedEnemyInSphere(center, radius, ownPawn);
+
+	// Without a manager there is no snapshot, ask the physics scene
 	TArray<FOverlapResult> overlaps;
+	GLADIATOR_COUNT_PHYSICS_QUERIES(1);
 
 	if (ownPawn->GetWorld()->OverlapMultiByObjectType(overlaps, center, FQuat::Identity, 
 		FCollisionObjectQueryParams::AllObjects, FCollisionShape::MakeSphere(radius)))
@@ -121,8 +169,8 @@ bool checkIfPawnIsInSphere(float radius, const FVector& center, APawn* ownPawn)
 				{
 					if (AEnemyCharacter* enemyCast = Cast<AEnemyCharacter>(pawnCast))
 					{
-						AAIController* enemyController = Cast<AAIController>(enemyCast->GetController());
-						if (enemyController->GetBlackboardComponent()->GetValueAsEnum("MovingState") == 4)
+						const AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCast->GetController());
+						if (enemyController && enemyController->GetMovingState() == EEnemyMovingState::PLACED)
 							return true;
 					}
 				}
@@ -134,7 +182,12 @@ bool checkIfPawnIsInSphere(float radius, const FVector& center, APawn* ownPawn)
 
 bool checkIfPawnEnemyIsFront(const FVector& start, const FVector& end, const APawn* ownPawn)
 {
+	const AAIC_Enemy* ownController = Cast<AAIC_Enemy>(ownPawn->GetController());
+	if (ownController && ownController->aiEnemyManager)
+		return ownController->aiEnemyManager->IsLineOfFireBlocked(start, end, ownPawn);
+
 	TArray<FHitResult> hits;
+	GLADIATOR_COUNT_PHYSICS_QUERIES(1);
 	if (ownPawn->GetWorld()->LineTraceMultiByObjectType(hits, start, end, FCollisionObjectQueryParams::AllObjects))
 	{
 		for (FHitResult hit : hits)
@@ -145,8 +198,8 @@ bool checkIfPawnEnemyIsFront(const FVector& start, const FVector& end, const APa
 				{
 					if (AEnemyCharacter* enemyCast = Cast<AEnemyCharacter>(hit.Actor))
 					{
-						AAIController* enemyController = Cast<AAIController>(enemyCast->GetController());
-						if (enemyController->GetBlackboardComponent()->GetValueAsEnum("MovingState") == 4)
+						const AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCast->GetController());
+						if (enemyController && enemyController->GetMovingState() == EEnemyMovingState::PLACED)
 							return true;
 					}
 				}
@@ -16,6 +16,4 @@ class GLADIATORGAME_API UBTS_AttackService : public UBTService_BlackboardBase
 
 public :
 	UBTS_AttackService(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
-
-	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 };
@@ -2,10 +2,14 @@
 
 
 #include "BTS_CheckPlayerDistance.h"
+#include "GladiatorGame.h"
+#include "AIEventLog.h"
+#include "GladiatorStats.h"
 #include "EnemyCharacter.h"
 #include "PlayerCharacter.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 
 UBTS_CheckPlayerDistance::UBTS_CheckPlayerDistance(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -14,23 +18,26 @@ UBTS_CheckPlayerDistance::UBTS_CheckPlayerDistance(const FObjectInitializer& Obj
 
 bool UBTS_CheckPlayerDistance::CalculateRawConditionValue(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) const
 {
-	float safePlayerDistanceMin = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMin");
-	float safePlayerDistanceMax = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMax");
+	GLADIATOR_SCOPE(STAT_GladiatorBTS_CheckPlayerDistance);
 
-	int enumId = OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState");
-	float distance = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("Distance");
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
 
-	const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
-	AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
+	const UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const FEnemyBlackboardKeys& keys = enemyController->GetBBKeys();
 
-	if (enumId != 5)
+	float safePlayerDistanceMin = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMin);
+	float safePlayerDistanceMax = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMax);
+
+	float distance = enemyController->GetPlayerDistance();
+
+	if (enemyController->GetMovingState() != EEnemyMovingState::GOING_BACK)
 	{
-		if (distance <= safePlayerDistanceMin)
+		if (distance <= safePlayerDistanceMin && enemyController->HandleEvent(EEnemyAIEvent::TOO_CLOSE))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("distance Failed, Distance = %f"), distance);
+			UE_LOG(LogGladiatorAI, Verbose, TEXT("%s too close, distance = %f"), *enemyController->GetName(), distance);
+			GLADIATOR_AI_EVENT(enemyController, "Too close", distance);
 
 			enemyController->StopMovement();
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 5);
 			return false;
 		}
 	}
@@ -42,7 +49,7 @@ bool UBTS_CheckPlayerDistance::CalculateRawConditionValue(UBehaviorTreeComponent
 		if (distance > distanceMin)
 		{
 			enemyController->StopMovement();
-			OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 0);
+			enemyController->HandleEvent(EEnemyAIEvent::BACK_IN_RANGE);
 			return true;
 		}
 
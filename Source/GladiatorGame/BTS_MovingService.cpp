@@ -2,23 +2,11 @@
 
 
 #include "BTS_MovingService.h"
-#include "EnemyCharacter.h"
-#include "PlayerCharacter.h"
-#include "BehaviorTree/BlackboardComponent.h"
-#include "AIC_Enemy.h"
 
 UBTS_MovingService::UBTS_MovingService(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NodeName = TEXT("Moving Service");
-}
-
-void UBTS_MovingService::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
-{
-	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
 
-	float distance = FVector::Dist(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation());
-	OwnerComp.GetBlackboardComponent()->SetValueAsFloat("Distance", distance);
-
-	OwnerComp.GetBlackboardComponent()->SetValueAsFloat("DeltaTime", DeltaSeconds);
-}
\ No newline at end of file
+	// Distance comes from the manager and RotateToPlayer reads the frame time itself, nothing is left to tick
+	bNotifyTick = false;
+}
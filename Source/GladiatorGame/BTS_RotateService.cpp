@@ -2,7 +2,7 @@
 
 
 #include "BTS_RotateService.h"
-#include "BehaviorTree/BlackboardComponent.h"
+#include "GladiatorStats.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnemyCharacter.h"
 #include "PlayerCharacter.h"
@@ -13,16 +13,32 @@ UBTS_RotateService::UBTS_RotateService(const FObjectInitializer& ObjectInitializ
 	NodeName = TEXT("Rotate Service");
 }
 
+uint16 UBTS_RotateService::GetInstanceMemorySize() const
+{
+	return sizeof(FBTRotateServiceMemory);
+}
+
+void UBTS_RotateService::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	FBTRotateServiceMemory* memory = reinterpret_cast<FBTRotateServiceMemory*>(NodeMemory);
+	memory->lastState = EEnemyMovingState::IDLE;
+}
+
 void UBTS_RotateService::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
-	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
+	GLADIATOR_SCOPE(STAT_GladiatorBTS_RotateService);
 
-	static int oldEnumId;
-	int enumId = OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState");
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(enemyController->GetPawn());
 
-	if (enumId != oldEnumId)
+	// Kept per enemy, a shared last state made enemies skip each other's changes
+	FBTRotateServiceMemory* memory = reinterpret_cast<FBTRotateServiceMemory*>(NodeMemory);
+	EEnemyMovingState state = enemyController->GetMovingState();
+
+	if (state != memory->lastState)
 	{
-		if (enumId >= 4 && enumId != 6)
+		if (state == EEnemyMovingState::PLACED || state == EEnemyMovingState::GOING_BACK ||
+			state == EEnemyMovingState::ATTACKING || state == EEnemyMovingState::DEAD)
 		{
 			enemyCharacter->GetCharacterMovement()->bOrientRotationToMovement = false;
 			enemyCharacter->bUseControllerRotationYaw = false;
@@ -32,10 +48,9 @@ void UBTS_RotateService::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* Node
 			enemyCharacter->GetCharacterMovement()->bOrientRotationToMovement = true;
 			enemyCharacter->bUseControllerRotationYaw = true;
 
-			AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCharacter->GetController());
 			enemyController->ClearFocus(EAIFocusPriority::Move);
 		}
 
-		oldEnumId = enumId;
+		memory->lastState = state;
 	}
-}
\ No newline at end of file
+}
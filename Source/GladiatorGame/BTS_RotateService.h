@@ -4,8 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/Services/BTService_BlackboardBase.h"
+#include "EnemyMovingState.h"
 #include "BTS_RotateService.generated.h"
 
+struct FBTRotateServiceMemory
+{
+	EEnemyMovingState lastState;
+};
+
 /**
  * 
  */
@@ -17,5 +23,8 @@ class GLADIATORGAME_API UBTS_RotateService : public UBTService_BlackboardBase
 public:
 	UBTS_RotateService(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 };
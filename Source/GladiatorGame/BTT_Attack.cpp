@@ -2,10 +2,10 @@
 
 
 #include "BTT_Attack.h"
+#include "GladiatorStats.h"
 #include "AIController.h"
 #include "AIC_Enemy.h"
 #include "EnemyCharacter.h"
-#include "BehaviorTree/BlackboardComponent.h"
 
 
 UBTT_Attack::UBTT_Attack(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -15,9 +15,11 @@ UBTT_Attack::UBTT_Attack(const FObjectInitializer& ObjectInitializer) : Super(Ob
 
 EBTNodeResult::Type UBTT_Attack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_Attack);
+
 	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
 	enemyCharacter->Attack();
-	OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 7);
+	Cast<AAIC_Enemy>(OwnerComp.GetAIOwner())->HandleEvent(EEnemyAIEvent::ATTACK_STARTED);
 
 	return EBTNodeResult::Succeeded;
 }
\ No newline at end of file
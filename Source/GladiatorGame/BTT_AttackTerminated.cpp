@@ -2,6 +2,7 @@
 
 
 #include "BTT_AttackTerminated.h"
+#include "GladiatorStats.h"
 #include "AIController.h"
 #include "AIC_Enemy.h"
 #include "EnemyCharacter.h"
@@ -14,6 +15,8 @@ UBTT_AttackTerminated::UBTT_AttackTerminated(const FObjectInitializer& ObjectIni
 
 EBTNodeResult::Type UBTT_AttackTerminated::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_AttackTerminated);
+
 	const AAIController* cont = OwnerComp.GetAIOwner();
 
 	APawn* enemyPawn = cont->GetPawn();
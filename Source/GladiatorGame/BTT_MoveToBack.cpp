@@ -2,35 +2,51 @@
 
 
 #include "BTT_MoveToBack.h"
+#include "GladiatorGame.h"
+#include "GladiatorStats.h"
 #include "AIC_Enemy.h"
 #include "PlayerCharacter.h"
 #include "EnemyCharacter.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 #include "NavigationSystem.h"
-#include "DrawDebugHelpers.h"
-#include "Math/UnrealMathUtility.h"
-#include "BTT_PlaceAroundPlayer.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "AIController.h"
 
 UBTT_MoveToBack::UBTT_MoveToBack(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NodeName = TEXT("Move To Back");
+	bNotifyTick = true;
+}
+
+uint16 UBTT_MoveToBack::GetInstanceMemorySize() const
+{
+	return sizeof(FBTMoveToBackMemory);
+}
+
+void UBTT_MoveToBack::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	FBTMoveToBackMemory* memory = reinterpret_cast<FBTMoveToBackMemory*>(NodeMemory);
+	memory->traceHandle = FTraceHandle();
+	memory->pathQueryId = INVALID_NAVQUERYID;
+	memory->endLocation = FVector::ZeroVector;
 }
 
 EBTNodeResult::Type UBTT_MoveToBack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_MoveToBack);
+
 	const AAIController* cont = OwnerComp.GetAIOwner();
 
 	APawn* enemyPawn = cont->GetPawn();
 	if (!enemyPawn)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("enemyPawn Failed"));
+		UE_LOG(LogGladiatorAI, Warning, TEXT("enemyPawn Failed"));
 		return EBTNodeResult::Failed;
 	}
 
-	const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(enemyPawn);
-	AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
-
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	const UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(FEnemyBlackboardKeys::Get(*blackboard).playerActor));
 	if (!playerCharacter)
 	{
 		return EBTNodeResult::Failed;
@@ -41,21 +57,123 @@ EBTNodeResult::Type UBTT_MoveToBack::ExecuteTask(UBehaviorTreeComponent& OwnerCo
 	FVector playerEnemyDir = enemyLocation - playerLocation;
 	playerEnemyDir.Normalize();
 
-	FVector endLocation = enemyLocation + playerEnemyDir * 200;
+	FBTMoveToBackMemory* memory = reinterpret_cast<FBTMoveToBackMemory*>(NodeMemory);
+	memory->endLocation = enemyLocation + playerEnemyDir * 200;
+	memory->pathQueryId = INVALID_NAVQUERYID;
+
+	GLADIATOR_COUNT_PHYSICS_QUERIES(1);
+
+	// Runs with the other async traces of the frame, TickTask picks the result up on the next one
+	memory->traceHandle = enemyPawn->GetWorld()->AsyncLineTraceByObjectType(EAsyncTraceType::Single, enemyLocation, memory->endLocation,
+		FCollisionObjectQueryParams::AllStaticObjects);
+
+	return EBTNodeResult::InProgress;
+}
+
+void UBTT_MoveToBack::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_MoveToBack);
+
+	FBTMoveToBackMemory* memory = reinterpret_cast<FBTMoveToBackMemory*>(NodeMemory);
+
+	// Already waiting for the path
+	if (!memory->traceHandle.IsValid())
+		return;
+
+	UWorld* world = OwnerComp.GetWorld();
+
+	FTraceDatum traceData;
+	FVector goal = memory->endLocation;
+
+	if (world->QueryTraceData(memory->traceHandle, traceData))
+	{
+		if (traceData.OutHits.Num() > 0)
+			goal = traceData.OutHits[0].Location;
+	}
+	else if (world->IsTraceHandleValid(memory->traceHandle, false))
+	{
+		return;
+	}
+
+	// A result dropped because the tree did not tick in time falls back on the unchecked end, the path query still keeps to the nav mesh
+	memory->traceHandle = FTraceHandle();
+	RequestPath(OwnerComp, memory, goal);
+}
+
+void UBTT_MoveToBack::RequestPath(UBehaviorTreeComponent& OwnerComp, FBTMoveToBackMemory* memory, const FVector& goal)
+{
+	AAIController* enemyController = OwnerComp.GetAIOwner();
+	APawn* enemyPawn = enemyController->GetPawn();
 
-	FHitResult hit;
-	FVector projectedLocation;
-	if (enemyPawn->GetWorld()->LineTraceSingleByObjectType(hit, enemyLocation, endLocation, FCollisionObjectQueryParams::AllStaticObjects))
+	UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(OwnerComp.GetWorld());
+	const ANavigationData* navData = navSys && enemyPawn ? navSys->GetNavDataForProps(enemyPawn->GetNavAgentPropertiesRef()) : nullptr;
+	if (!navData)
 	{
-		projectedLocation = ProjectPointOnNavigableLocation(hit.Location, enemyPawn);
+		UE_LOG(LogGladiatorAI, Warning, TEXT("NavSys Failed"));
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
 	}
-	else
+
+	// The query projects its ends on the nav mesh itself, no separate projection needed
+	FPathFindingQuery query(enemyController, *navData, enemyPawn->GetNavAgentLocation(), goal,
+		UNavigationQueryFilter::GetQueryFilter(*navData, enemyController, enemyController->GetDefaultNavigationFilterClass()));
+
+	INC_DWORD_STAT(STAT_GladiatorNavPathRequests);
+	memory->pathQueryId = navSys->FindPathAsync(enemyPawn->GetNavAgentPropertiesRef(), query,
+		FNavPathQueryDelegate::CreateUObject(this, &UBTT_MoveToBack::OnPathFound, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+
+	if (memory->pathQueryId == INVALID_NAVQUERYID)
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+}
+
+void UBTT_MoveToBack::OnPathFound(uint32 queryId, ENavigationQueryResult::Type result, FNavPathSharedPtr path, TWeakObjectPtr<UBehaviorTreeComponent> ownerComp)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_MoveToBack);
+
+	UBehaviorTreeComponent* OwnerComp = ownerComp.Get();
+	if (!OwnerComp)
+		return;
+
+	FBTMoveToBackMemory* memory = reinterpret_cast<FBTMoveToBackMemory*>(OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)));
+
+	// The task was aborted or started again since, this answer belongs to an older request
+	if (!memory || memory->pathQueryId != queryId)
+		return;
+
+	memory->pathQueryId = INVALID_NAVQUERYID;
+
+	AAIController* enemyController = OwnerComp->GetAIOwner();
+	if (result != ENavigationQueryResult::Success || !path.IsValid() || !enemyController)
 	{
-		projectedLocation = ProjectPointOnNavigableLocation(endLocation, enemyPawn);
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Failed);
+		return;
 	}
 
-	enemyController->MoveToLocation(projectedLocation, 100);
+	FAIMoveRequest moveRequest(path->GetEndLocation());
+	moveRequest.SetAcceptanceRadius(100);
+
+	path->EnableRecalculationOnInvalidation(true);
+	enemyController->RequestMove(moveRequest, path);
 
-	return EBTNodeResult::Succeeded;
+	FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
 }
 
+EBTNodeResult::Type UBTT_MoveToBack::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_MoveToBack);
+
+	FBTMoveToBackMemory* memory = reinterpret_cast<FBTMoveToBackMemory*>(NodeMemory);
+
+	if (memory->pathQueryId != INVALID_NAVQUERYID)
+	{
+		if (UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(OwnerComp.GetWorld()))
+			navSys->AbortAsyncFindPathRequest(memory->pathQueryId);
+
+		memory->pathQueryId = INVALID_NAVQUERYID;
+	}
+
+	// The pending trace is simply never read
+	memory->traceHandle = FTraceHandle();
+
+	return EBTNodeResult::Aborted;
+}
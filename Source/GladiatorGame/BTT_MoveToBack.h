@@ -4,8 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "NavigationData.h"
 #include "BTT_MoveToBack.generated.h"
 
+struct FBTMoveToBackMemory
+{
+	FTraceHandle traceHandle;
+	uint32 pathQueryId;
+	FVector endLocation;
+};
+
 /**
  * 
  */
@@ -16,5 +24,15 @@ class GLADIATORGAME_API UBTT_MoveToBack : public UBTTask_BlackboardBase
 public :
 	UBTT_MoveToBack(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+
+protected:
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
+private:
+	void RequestPath(UBehaviorTreeComponent& OwnerComp, FBTMoveToBackMemory* memory, const FVector& goal);
+	void OnPathFound(uint32 queryId, ENavigationQueryResult::Type result, FNavPathSharedPtr path, TWeakObjectPtr<UBehaviorTreeComponent> ownerComp);
 };
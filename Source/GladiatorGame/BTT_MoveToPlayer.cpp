@@ -1,10 +1,12 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "BTT_MoveToPlayer.h"
+#include "GladiatorStats.h"
 #include "AIC_Enemy.h"
 #include "PlayerCharacter.h"
 #include "EnemyCharacter.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 #include "NavigationSystem.h"
 #include "DrawDebugHelpers.h"
 #include "Math/UnrealMathUtility.h"
@@ -16,10 +18,13 @@ UBTT_MoveToPlayer::UBTT_MoveToPlayer(const FObjectInitializer& ObjectInitializer
 
 EBTNodeResult::Type UBTT_MoveToPlayer::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_MoveToPlayer);
+
 	const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
 	AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
 	
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	const UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(FEnemyBlackboardKeys::Get(*blackboard).playerActor));
 
 	float playerSpeed = FVector::VectorPlaneProject(playerCharacter->GetVelocity(), FVector(0, 0, 1)).Size();
 
@@ -2,14 +2,19 @@
 
 
 #include "BTT_PlaceAroundPlayer.h"
+#include "GladiatorGame.h"
+#include "AIEventLog.h"
+#include "GladiatorStats.h"
 #include "AIC_Enemy.h"
 #include "PlayerCharacter.h"
 #include "EnemyCharacter.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 #include "NavigationSystem.h"
 #include "DrawDebugHelpers.h"
 #include "Math/UnrealMathUtility.h"
-#include "BTD_CheckPlacing.h"
+#include "AIEnemyManager.h"
+#include "PlacementSolver.h"
 
 UBTT_PlaceAroundPlayer::UBTT_PlaceAroundPlayer(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -21,13 +26,14 @@ FVector ProjectPointOnNavigableLocation(FVector desiredLocation, APawn* enemyPaw
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(enemyPawn->GetWorld());
 	if (!NavSys)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("NavSys Failed"));
+		UE_LOG(LogGladiatorAI, Warning, TEXT("NavSys Failed"));
 		return FVector::ZeroVector;
 	}
 
 	const FNavAgentProperties& AgentProps = enemyPawn->GetNavAgentPropertiesRef();
 	FNavLocation target;
 
+	GLADIATOR_COUNT_NAV_PROJECTIONS(1);
 	NavSys->ProjectPointToNavigation(desiredLocation, target, INVALID_NAVEXTENT, &AgentProps);
 
 	return target.Location;
@@ -39,26 +45,23 @@ FVector UBTT_PlaceAroundPlayer::GetPointRadiusOnNavigableLocation(FVector origin
 	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(enemyPawn->GetWorld());
 	if (!NavSys)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("NavSys Failed"));
+		UE_LOG(LogGladiatorAI, Warning, TEXT("NavSys Failed"));
 	}
 	FNavLocation target;
 
 	NavSys->GetRandomReachablePointInRadius(originLocation, radius, target);
-	UE_LOG(LogTemp, Warning, TEXT("target location = (%f,%f,%f)"), target.Location.X, target.Location.Y, target.Location.Z);
+	UE_LOG(LogGladiatorAI, VeryVerbose, TEXT("target location = (%f,%f,%f)"), target.Location.X, target.Location.Y, target.Location.Z);
 
 	return target.Location;
 }
 
-FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unitAxisB)
+static FVector GetPointInSemiTorus(float angle, float radius, const FVector& unitAxisB)
 {
-
-	float randomAngle = FMath::RandRange(0.f, 6.28f);
-
-	float cX = FMath::Sin(randomAngle);
-	float cY = FMath::Cos(randomAngle);
+	float cX = FMath::Sin(angle);
+	float cY = FMath::Cos(angle);
 
 	FVector ringPos = FVector(cX, cY, 0);
-	ringPos *= FMath::RandRange(radiusMin, radiusMax);
+	ringPos *= radius;
 
 	FVector result = (ringPos);
 	result.Y = FMath::Abs(result.Y);
@@ -67,59 +70,85 @@ FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unit
 	FQuat quaternionResult = FQuat::FindBetweenVectors(unitAxisA, unitAxisB);
 	
 	return quaternionResult.RotateVector(result);
+}
 
-	//return result;
+FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unitAxisB)
+{
+	return GetPointInSemiTorus(FMath::RandRange(0.f, 6.28f), FMath::RandRange(radiusMin, radiusMax), unitAxisB);
+}
+
+FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unitAxisB, FRandomStream& stream)
+{
+	return GetPointInSemiTorus(stream.FRandRange(0.f, 6.28f), stream.FRandRange(radiusMin, radiusMax), unitAxisB);
 }
 
 EBTNodeResult::Type UBTT_PlaceAroundPlayer::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	float safePlayerDistanceMin = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMin");
-	float safePlayerDistanceMax = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("safePlayerDistanceMax");
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_PlaceAroundPlayer);
+
+	UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const FEnemyBlackboardKeys& keys = FEnemyBlackboardKeys::Get(*blackboard);
+
+	float safePlayerDistanceMin = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMin);
+	float safePlayerDistanceMax = blackboard->GetValue<UBlackboardKeyType_Float>(keys.safePlayerDistanceMax);
 
 	const AAIController* cont = OwnerComp.GetAIOwner();
 
 	APawn* enemyPawn = cont->GetPawn();
 
 	const AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(enemyPawn);
-	AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(enemyCharacter->GetController());
 
-	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	const APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(keys.playerActor));
 
-	FVector enemyLocation = enemyPawn->GetActorLocation();
-	FVector playerLocation = playerCharacter->GetActorLocation();
-	FVector playerEnemyDir = enemyLocation - playerLocation;
-	playerEnemyDir.Normalize();
+	if (!enemyController->aiEnemyManager)
+		return EBTNodeResult::Failed;
 
-	bool result = false;
-	int iteration = 0;
-	FVector projectedLocation;
-
-	while (!result && iteration < 10)
+	// The ring slot given by the manager comes first, the solver only places enemies left without one
+	FVector slotLocation;
+	if (enemyController->aiEnemyManager->GetSlotLocation(enemyController, slotLocation))
 	{
-		iteration++;
+		enemyController->MoveToLocation(slotLocation);
+
+		enemyController->HandleEvent(EEnemyAIEvent::PLACE_CHOSEN);
+		INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+		blackboard->SetValue<UBlackboardKeyType_Vector>(keys.currentTarget, slotLocation);
 
-		FVector randomLocation = GetRandomPointInSemiTorus(safePlayerDistanceMin,
-			safePlayerDistanceMax, playerEnemyDir);
+		return EBTNodeResult::Succeeded;
+	}
 
-		projectedLocation = ProjectPointOnNavigableLocation(randomLocation + playerLocation, enemyPawn);
+	// The solver is the expensive part, wait for a frame with budget left and try again
+	if (!enemyController->IsEvaluationAllowed())
+		return EBTNodeResult::Failed;
 
-		float dist = FVector::Dist(projectedLocation, playerLocation);
-		if (dist < safePlayerDistanceMin || dist > safePlayerDistanceMax)
-			continue;
+	FAIBudgetScope budgetScope(&enemyController->aiEnemyManager->GetBudgetScheduler());
 
-		if (checkIfPawnEnemyIsFront(projectedLocation, playerLocation, enemyPawn))
-			continue;
-		
-		if (checkIfPawnIsInSphere(enemyCharacter->wantedRoomRadius, projectedLocation, enemyPawn))
-			continue;
+	FPlacementRequest request;
+	request.pawn = enemyPawn;
+	request.enemyLocation = enemyPawn->GetActorLocation();
+	request.playerLocation = playerCharacter->GetActorLocation();
+	request.distanceMin = safePlayerDistanceMin;
+	request.distanceMax = safePlayerDistanceMax;
+	request.roomRadius = enemyCharacter->wantedRoomRadius;
+	// From the global stream like the rest of the AI's dice, a run seeded with FMath::RandInit replays the same placements
+	request.seed = FMath::Rand();
 
-		result = true;
-	}
+	FPlacementResult placement = enemyController->aiEnemyManager->SolvePlacement(request);
+
+	UE_LOG(LogGladiatorAI, Verbose, TEXT("%s placement: found = %i, rejected nav = %i, range = %i, line of fire = %i, crowded = %i"),
+		*enemyPawn->GetName(), placement.found, placement.rejectedOffNavMesh, placement.rejectedOutOfRange,
+		placement.rejectedLineOfFire, placement.rejectedCrowded);
+	GLADIATOR_AI_EVENT(enemyPawn, "Placement found", placement.found ? 1.f : 0.f);
+
+	// Stay in the replacing state and try again rather than walking to a rejected point
+	if (!placement.found)
+		return EBTNodeResult::Failed;
 
-	enemyController->MoveToLocation(projectedLocation);
+	enemyController->MoveToLocation(placement.location);
 
-	OwnerComp.GetBlackboardComponent()->SetValueAsEnum("MovingState", 3);
-	OwnerComp.GetBlackboardComponent()->SetValueAsVector("currentTarget", projectedLocation);
+	enemyController->HandleEvent(EEnemyAIEvent::PLACE_CHOSEN);
+	INC_DWORD_STAT(STAT_GladiatorBlackboardWrites);
+	blackboard->SetValue<UBlackboardKeyType_Vector>(keys.currentTarget, placement.location);
 
 	return EBTNodeResult::Succeeded;
 
@@ -24,3 +24,4 @@ public :
 
 FVector ProjectPointOnNavigableLocation(FVector desiredLocation, APawn* enemyPawn);
 FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unitAxisB);
+FVector GetRandomPointInSemiTorus(float radiusMin, float radiusMax, FVector unitAxisB, FRandomStream& stream);
@@ -2,10 +2,12 @@
 
 
 #include "BTT_RotateToPlayer.h"
+#include "GladiatorStats.h"
 #include "AIC_Enemy.h"
 #include "PlayerCharacter.h"
 #include "EnemyCharacter.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "EnemyBlackboardKeys.h"
 #include "GameFramework/Controller.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -19,21 +21,27 @@ UBTT_RotateToPlayer::UBTT_RotateToPlayer(const FObjectInitializer& ObjectInitial
 
 EBTNodeResult::Type UBTT_RotateToPlayer::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	int enumId = OwnerComp.GetBlackboardComponent()->GetValueAsEnum("MovingState");
+	GLADIATOR_SCOPE(STAT_GladiatorBTT_RotateToPlayer);
 
-	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(OwnerComp.GetAIOwner()->GetPawn());
-	AAIController* enemyController = Cast<AAIController>(enemyCharacter->GetController());
-	APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("PlayerActor"));
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(OwnerComp.GetAIOwner());
+	AEnemyCharacter* enemyCharacter = Cast<AEnemyCharacter>(enemyController->GetPawn());
 
-	if (enumId >= 4 && enumId != 5)
+	const UBlackboardComponent* blackboard = OwnerComp.GetBlackboardComponent();
+	const FEnemyBlackboardKeys& keys = enemyController->GetBBKeys();
+
+	EEnemyMovingState state = enemyController->GetMovingState();
+	APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(blackboard->GetValue<UBlackboardKeyType_Object>(keys.playerActor));
+
+	if (state == EEnemyMovingState::PLACED || state == EEnemyMovingState::ATTACK ||
+		state == EEnemyMovingState::ATTACKING || state == EEnemyMovingState::DEAD)
 	{
-		float deltaTime = OwnerComp.GetBlackboardComponent()->GetValueAsFloat("DeltaTime");
+		float deltaTime = enemyCharacter->GetWorld()->GetDeltaSeconds();
 		FRotator lookAt = UKismetMathLibrary::FindLookAtRotation(enemyCharacter->GetActorLocation(), playerCharacter->GetActorLocation());
 		FRotator rotator = UKismetMathLibrary::RInterpTo(enemyCharacter->GetActorRotation(), lookAt, deltaTime, enemyCharacter->rotateSpeed);
 
 		enemyCharacter->SetActorRotation(rotator.Quaternion());
 	}
-	else if (enumId == 5)
+	else if (state == EEnemyMovingState::GOING_BACK)
 	{
 		enemyController->SetFocalPoint(playerCharacter->GetActorLocation(), EAIFocusPriority::Move);
 	}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CombatSubsystem.h"
+#include "GladiatorGameCharacter.h"
+#include "GladiatorStats.h"
+#include "LifeComponent.h"
+
+void UCombatSubsystem::QueueDamage(const AGladiatorGameCharacter* attacker, AGladiatorGameCharacter* victim, int damage)
+{
+	INC_DWORD_STAT(STAT_GladiatorDamageEvents);
+
+	const FGladiatorDamageEvent* firstHit = damageEvents.FindByPredicate([victim](const FGladiatorDamageEvent& other) { return other.victim == victim; });
+	const int32 group = firstHit ? firstHit->group : damageEvents.Num();
+
+	FGladiatorDamageEvent& event = damageEvents.AddDefaulted_GetRef();
+	event.victim = victim;
+	event.senderLocation = attacker->GetActorLocation();
+	event.damage = damage;
+	event.order = damageEvents.Num() - 1;
+	event.group = group;
+}
+
+void UCombatSubsystem::AddCooldown(ULifeComponent* life, float expiryTime)
+{
+	cooldowns.Add({ life, expiryTime });
+}
+
+void UCombatSubsystem::Tick(float DeltaTime)
+{
+	// Hits of this frame see the invincibilities that ran out before it as over
+	ExpireCooldowns();
+
+	if (damageEvents.Num() > 0)
+		ResolveDamage();
+}
+
+void UCombatSubsystem::ExpireCooldowns()
+{
+	const float time = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = cooldowns.Num() - 1; i >= 0; i--)
+	{
+		const FCombatCooldown cooldown = cooldowns[i];
+		if (cooldown.expiryTime > time)
+			continue;
+
+		cooldowns.RemoveAtSwap(i, 1, false);
+
+		if (cooldown.life)
+			cooldown.life->OnInvincibilityExpired(cooldown.expiryTime);
+	}
+}
+
+void UCombatSubsystem::ResolveDamage()
+{
+	GLADIATOR_SCOPE(STAT_GladiatorDamageResolution);
+
+	// Hits on the same victim next to each other, in the order they landed, the victims in the order they were first hit
+	damageEvents.Sort([](const FGladiatorDamageEvent& a, const FGladiatorDamageEvent& b)
+	{
+		return a.group != b.group ? a.group < b.group : a.order < b.order;
+	});
+
+	int32 first = 0;
+	while (first < damageEvents.Num())
+	{
+		AGladiatorGameCharacter* victim = damageEvents[first].victim;
+
+		int32 last = first;
+		while (last + 1 < damageEvents.Num() && damageEvents[last + 1].victim == victim)
+			last++;
+
+		if (victim && victim->isAlive())
+		{
+			// Each unblocked hit goes through Hurt, the invincibility of the first one absorbs the others as before
+			for (int32 i = first; i <= last; i++)
+			{
+				if (!victim->BlockHit(damageEvents[i].senderLocation))
+					victim->healthComponent->Hurt(damageEvents[i].damage);
+			}
+		}
+
+		first = last + 1;
+	}
+
+	damageEvents.Reset();
+}
+
+ETickableTickType UCombatSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UCombatSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSubsystem, STATGROUP_Tickables);
+}
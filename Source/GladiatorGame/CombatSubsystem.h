@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "CombatSubsystem.generated.h"
+
+class AGladiatorGameCharacter;
+class ULifeComponent;
+
+USTRUCT()
+struct FGladiatorDamageEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AGladiatorGameCharacter* victim = nullptr;
+
+	/** Where the hit came from, for the shield check */
+	FVector senderLocation = FVector::ZeroVector;
+
+	int damage = 0;
+
+	/** Queue order, keeps hits on one victim in the order they landed */
+	int32 order = 0;
+
+	/** order of the first hit on the same victim, victims are resolved in the order they were first hit */
+	int32 group = 0;
+};
+
+USTRUCT()
+struct FCombatCooldown
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ULifeComponent* life = nullptr;
+
+	float expiryTime = 0.f;
+};
+
+/**
+ * Hits of the frame, queued by the weapons and resolved together once per frame.
+ * Each victim gets its hits in the order they landed, the invincibility of the first one absorbs the next ones.
+ * Also ends the invincibilities, checked against their expiry time each frame instead of a timer each.
+ */
+UCLASS()
+class GLADIATORGAME_API UCombatSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGladiatorDamageEvent> damageEvents;
+
+	UPROPERTY()
+	TArray<FCombatCooldown> cooldowns;
+
+	void ResolveDamage();
+	void ExpireCooldowns();
+
+public:
+	void QueueDamage(const AGladiatorGameCharacter* attacker, AGladiatorGameCharacter* victim, int damage);
+
+	/** life hears OnInvincibilityExpired at the first frame past expiryTime */
+	void AddCooldown(ULifeComponent* life, float expiryTime);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return damageEvents.Num() > 0 || cooldowns.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CorpseSubsystem.h"
+#include "GladiatorGameCharacter.h"
+#include "EnemyCharacter.h"
+#include "EnemyPoolSubsystem.h"
+#include "GladiatorStats.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+
+void UCorpseSubsystem::AddCorpse(AGladiatorGameCharacter* body)
+{
+	const float time = GetWorld()->GetTimeSeconds();
+
+	// Over the cap the oldest ragdoll makes room, the new one is the one players look at
+	if (simulatingCount >= FMath::Max(maxSimulatingRagdolls, 1))
+	{
+		for (FCorpse& corpse : corpses)
+		{
+			if (corpse.frozenTime < 0.f)
+			{
+				Freeze(corpse, time);
+				break;
+			}
+		}
+	}
+
+	FCorpse& corpse = corpses.AddDefaulted_GetRef();
+	corpse.body = body;
+	corpse.deathTime = time;
+	simulatingCount++;
+}
+
+void UCorpseSubsystem::Freeze(FCorpse& corpse, float time)
+{
+	corpse.frozenTime = time;
+	simulatingCount--;
+
+	corpse.body->FreezeRagdoll([this](UStaticMesh* mesh, const FTransform& transform)
+	{
+		AddPropInstance(mesh, transform);
+	});
+}
+
+void UCorpseSubsystem::AddPropInstance(UStaticMesh* mesh, const FTransform& transform)
+{
+	if (!propsActor)
+	{
+		FActorSpawnParameters spawnParams;
+		spawnParams.Name = TEXT("CorpseProps");
+		spawnParams.ObjectFlags |= RF_Transient;
+
+		propsActor = GetWorld()->SpawnActor<AActor>(spawnParams);
+		propsActor->SetRootComponent(NewObject<USceneComponent>(propsActor, TEXT("Root")));
+		propsActor->GetRootComponent()->RegisterComponent();
+	}
+
+	FCorpseProps& props = propInstances.FindOrAdd(mesh);
+	if (!props.instances)
+	{
+		UHierarchicalInstancedStaticMeshComponent* instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(propsActor);
+		instances->SetStaticMesh(mesh);
+		instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		instances->SetCanEverAffectNavigation(false);
+		instances->SetupAttachment(propsActor->GetRootComponent());
+		instances->RegisterComponent();
+		propsActor->AddInstanceComponent(instances);
+		props.instances = instances;
+	}
+
+	// Moving the oldest instance keeps the indices and the instance buffer the same size, bodies keep coming back from the pool
+	if (props.instances->GetInstanceCount() < FMath::Max(maxPropInstances, 1))
+	{
+		props.instances->AddInstanceWorldSpace(transform);
+		return;
+	}
+
+	props.instances->UpdateInstanceTransform(props.oldest, transform, true, true);
+	props.oldest = (props.oldest + 1) % props.instances->GetInstanceCount();
+}
+
+void UCorpseSubsystem::Tick(float DeltaTime)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorCorpses);
+
+	const float time = GetWorld()->GetTimeSeconds();
+	UEnemyPoolSubsystem* pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+
+	// One compaction pass that keeps the death order AddCorpse relies on to find the oldest ragdoll
+	corpses.RemoveAll([this, time, pool](FCorpse& corpse)
+	{
+		if (!IsValid(corpse.body))
+		{
+			if (corpse.frozenTime < 0.f)
+				simulatingCount--;
+
+			return true;
+		}
+
+		if (corpse.frozenTime < 0.f)
+		{
+			const float lifeTime = time - corpse.deathTime;
+			if (lifeTime >= ragdollTimeout || (lifeTime >= minRagdollTime && corpse.body->IsRagdollAsleep()))
+				Freeze(corpse, time);
+
+			return false;
+		}
+
+		// The player stays where it fell, only enemies are pooled
+		AEnemyCharacter* enemy = Cast<AEnemyCharacter>(corpse.body);
+		if (!enemy || !pool)
+			return true;
+
+		if (time - corpse.frozenTime >= corpseTime)
+		{
+			pool->Release(enemy);
+			return true;
+		}
+
+		return false;
+	});
+
+	SET_DWORD_STAT(STAT_GladiatorSimulatingRagdolls, simulatingCount);
+}
+
+ETickableTickType UCorpseSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UCorpseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCorpseSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "CorpseSubsystem.generated.h"
+
+class AGladiatorGameCharacter;
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+
+USTRUCT()
+struct FCorpse
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AGladiatorGameCharacter* body = nullptr;
+
+	float deathTime = 0.f;
+
+	/** Negative while the ragdoll still simulates */
+	float frozenTime = -1.f;
+};
+
+USTRUCT()
+struct FCorpseProps
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UHierarchicalInstancedStaticMeshComponent* instances = nullptr;
+
+	/** Instance replaced by the next prop once maxPropInstances is reached, the oldest one */
+	int32 oldest = 0;
+};
+
+/**
+ * Looks after the ragdolls of dead gladiators, at most maxSimulatingRagdolls of them simulate at once.
+ * A ragdoll that has settled or timed out is frozen in its last pose and its dropped weapons become instances.
+ * Frozen enemies go back to the enemy pool after corpseTime, their weapons stay until newer ones take their instances.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UCorpseSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	/** In death order */
+	UPROPERTY()
+	TArray<FCorpse> corpses;
+
+	int32 simulatingCount = 0;
+
+	/** Holds the instanced dropped weapons */
+	UPROPERTY()
+	AActor* propsActor;
+
+	UPROPERTY()
+	TMap<UStaticMesh*, FCorpseProps> propInstances;
+
+	void Freeze(FCorpse& corpse, float time);
+	void AddPropInstance(UStaticMesh* mesh, const FTransform& transform);
+
+public:
+	UPROPERTY(config)
+	int maxSimulatingRagdolls = 8;
+
+	/** Seconds before a ragdoll that is still awake is frozen anyway */
+	UPROPERTY(config)
+	float ragdollTimeout = 5.f;
+
+	/** Seconds before a ragdoll can be frozen for being asleep, it has not fallen yet on the first frames */
+	UPROPERTY(config)
+	float minRagdollTime = 0.5f;
+
+	/** Seconds a frozen enemy stays on the ground before it is pooled */
+	UPROPERTY(config)
+	float corpseTime = 5.f;
+
+	/** Dropped weapons kept per mesh, past that a new one moves the oldest */
+	UPROPERTY(config)
+	int maxPropInstances = 64;
+
+	void AddCorpse(AGladiatorGameCharacter* body);
+
+	int32 GetSimulatingCount() const { return simulatingCount; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return corpses.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EncirclementPlanner.h"
+#include "PlacementSolver.h"
+
+void FEncirclementPlanner::Configure(float radius, float spacing)
+{
+	const int32 count = FMath::Max(FMath::FloorToInt(2.f * PI * radius / FMath::Max(spacing, 1.f)), 1);
+	angleStep = 2.f * PI / count;
+
+	slotOffsets.SetNumUninitialized(count);
+	for (int32 i = 0; i < count; i++)
+	{
+		float sin, cos;
+		FMath::SinCos(&sin, &cos, i * angleStep);
+		slotOffsets[i] = FVector(cos, sin, 0.f) * radius;
+	}
+
+	slotLocations.Init(FVector::ZeroVector, count);
+	slotValid.Init(false, count);
+	slotOwners.Init(nullptr, count);
+	enemySlots.Reset();
+
+	hasAnchor = false;
+}
+
+bool FEncirclementPlanner::UpdateAnchor(const FVector& playerLocation, float tolerance, const APawn* navAgent, UWorld* world)
+{
+	if (hasAnchor && FVector::DistSquared2D(anchor, playerLocation) <= tolerance * tolerance)
+		return false;
+
+	anchor = playerLocation;
+	hasAnchor = true;
+
+	projectedPoints.Reset(Num());
+	for (const FVector& offset : slotOffsets)
+		projectedPoints.Add(anchor + offset);
+
+	ProjectPointsOnNavigableLocation(projectedPoints, projectionWork, navAgent, world);
+
+	for (int32 i = 0; i < Num(); i++)
+	{
+		slotValid[i] = projectionWork[i].bResult;
+		slotLocations[i] = slotValid[i] ? projectionWork[i].OutLocation.Location : projectedPoints[i];
+
+		// A slot that left the nav mesh frees its enemy, it gets a new one on its next assignment
+		if (!slotValid[i] && slotOwners[i])
+		{
+			enemySlots.Remove(slotOwners[i]);
+			slotOwners[i] = nullptr;
+		}
+	}
+
+	return true;
+}
+
+int32 FEncirclementPlanner::GetSlot(const AAIC_Enemy* enemy) const
+{
+	const int32* slot = enemySlots.Find(enemy);
+	return slot ? *slot : INDEX_NONE;
+}
+
+int32 FEncirclementPlanner::Assign(const AAIC_Enemy* enemy, const FVector& enemyLocation)
+{
+	const int32 current = GetSlot(enemy);
+	if (current != INDEX_NONE || !hasAnchor)
+		return current;
+
+	const int32 count = Num();
+	const float angle = FMath::Atan2(enemyLocation.Y - anchor.Y, enemyLocation.X - anchor.X);
+	const int32 preferred = FMath::RoundToInt(angle / angleStep);
+
+	// Walk outwards from the slot facing the enemy, alternating sides
+	for (int32 step = 0; step <= count / 2; step++)
+	{
+		for (int32 side = step == 0 ? 1 : -1; side <= 1; side += 2)
+		{
+			const int32 slot = ((preferred + side * step) % count + count) % count;
+			if (!slotValid[slot] || slotOwners[slot])
+				continue;
+
+			slotOwners[slot] = enemy;
+			enemySlots.Add(enemy, slot);
+			return slot;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FEncirclementPlanner::Release(const AAIC_Enemy* enemy)
+{
+	int32 slot;
+	if (enemySlots.RemoveAndCopyValue(enemy, slot))
+		slotOwners[slot] = nullptr;
+}
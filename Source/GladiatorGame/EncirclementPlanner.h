@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+
+class APawn;
+class UWorld;
+class AAIC_Enemy;
+
+/**
+ * Ring of angular slots around the player, each slot held by at most one enemy.
+ * Enemies keep their slot until they release it, so the formation only changes where it has to.
+ */
+class GLADIATORGAME_API FEncirclementPlanner
+{
+public:
+	/** Lays out as many slots as fit on the ring with spacing between them, drops every assignment */
+	void Configure(float radius, float spacing);
+
+	/** Moves the ring when the player went further than tolerance from it, returns true if the slots moved */
+	bool UpdateAnchor(const FVector& playerLocation, float tolerance, const APawn* navAgent, UWorld* world);
+
+	/** Slot held by the enemy, INDEX_NONE if it has none */
+	int32 GetSlot(const AAIC_Enemy* enemy) const;
+
+	/** Gives the enemy the free slot closest to its angle around the player, INDEX_NONE if every slot is taken */
+	int32 Assign(const AAIC_Enemy* enemy, const FVector& enemyLocation);
+
+	void Release(const AAIC_Enemy* enemy);
+
+	const FVector& GetSlotLocation(int32 slot) const { return slotLocations[slot]; }
+
+	int32 Num() const { return slotOffsets.Num(); }
+
+private:
+	FVector anchor = FVector::ZeroVector;
+	bool hasAnchor = false;
+
+	float angleStep = 0.f;
+
+	TArray<FVector> slotOffsets;
+	TArray<FVector> slotLocations;
+	TArray<bool> slotValid;
+	TArray<const AAIC_Enemy*> slotOwners;
+
+	TMap<const AAIC_Enemy*, int32> enemySlots;
+
+	TArray<FVector> projectedPoints;
+	TArray<FNavigationProjectionWork> projectionWork;
+};
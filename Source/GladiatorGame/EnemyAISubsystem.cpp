@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyAISubsystem.h"
+#include "GladiatorGame.h"
+#include "AIEnemyManager.h"
+
+void UEnemyAISubsystem::RegisterManager(AAIEnemyManager* newManager)
+{
+	if (manager && manager != newManager)
+	{
+		UE_LOG(LogGladiatorAI, Warning, TEXT("Second enemy manager %s ignored, %s is already registered"), *newManager->GetName(), *manager->GetName());
+		return;
+	}
+
+	manager = newManager;
+	accumulator = 0.f;
+}
+
+void UEnemyAISubsystem::UnregisterManager(AAIEnemyManager* oldManager)
+{
+	if (manager == oldManager)
+		manager = nullptr;
+}
+
+void UEnemyAISubsystem::Tick(float DeltaTime)
+{
+	const float step = 1.f / FMath::Max(simulationRate, 1.f);
+	accumulator += DeltaTime;
+
+	const double startTime = FPlatformTime::Seconds();
+
+	int steps = 0;
+	while (accumulator >= step && steps < maxStepsPerFrame)
+	{
+		manager->StepSimulation(step);
+		accumulator -= step;
+		steps++;
+	}
+
+	if (accumulator >= step)
+		accumulator = FMath::Fmod(accumulator, step);
+
+	lastStepsSeconds = FPlatformTime::Seconds() - startTime;
+}
+
+ETickableTickType UEnemyAISubsystem::GetTickableTickType() const
+{
+	// The class default object never ticks, instances only while a manager is registered
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UEnemyAISubsystem::IsTickable() const
+{
+	return manager != nullptr && manager->HasActorBegunPlay();
+}
+
+TStatId UEnemyAISubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAISubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "EnemyAISubsystem.generated.h"
+
+class AAIEnemyManager;
+
+/**
+ * Knows the enemy manager of the world, so enemies do not search the level for it.
+ * Also runs the manager's AI at a fixed rate, whatever the frame rate.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UEnemyAISubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AAIEnemyManager* manager;
+
+	/** Time not simulated yet, always less than a step once the frame is done */
+	float accumulator = 0.f;
+
+	/** Wall time spent in the steps of the last frame */
+	double lastStepsSeconds = 0.0;
+
+public:
+	/** AI steps per second */
+	UPROPERTY(config)
+	float simulationRate = 30.f;
+
+	/** Past this many steps in one frame the late time is dropped, a slow frame does not make the next one slower */
+	UPROPERTY(config)
+	int maxStepsPerFrame = 4;
+
+	void RegisterManager(AAIEnemyManager* newManager);
+	void UnregisterManager(AAIEnemyManager* oldManager);
+
+	AAIEnemyManager* GetManager() const { return manager; }
+
+	double GetLastStepsSeconds() const { return lastStepsSeconds; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyBlackboardKeys.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	TMap<TObjectKey<UBlackboardData>, FEnemyBlackboardKeys> resolvedKeys;
+
+	// Every enemy shares the same blackboard asset, so the last lookup almost always hits
+	TObjectKey<UBlackboardData> lastAsset;
+	const FEnemyBlackboardKeys* lastKeys = nullptr;
+
+	const FEnemyBlackboardKeys invalidKeys;
+}
+
+const FEnemyBlackboardKeys& FEnemyBlackboardKeys::Get(const UBlackboardComponent& blackboard)
+{
+	return Get(blackboard.GetBlackboardAsset());
+}
+
+const FEnemyBlackboardKeys& FEnemyBlackboardKeys::Get(const UBlackboardData* asset)
+{
+	if (!asset)
+		return invalidKeys;
+
+	const TObjectKey<UBlackboardData> assetKey(asset);
+	if (lastKeys && lastAsset == assetKey)
+		return *lastKeys;
+
+	FEnemyBlackboardKeys* keys = resolvedKeys.Find(assetKey);
+	if (!keys)
+	{
+		keys = &resolvedKeys.Add(assetKey);
+		keys->Resolve(*asset);
+	}
+
+	// Adding to the map may have moved the previous entries
+	lastAsset = assetKey;
+	lastKeys = keys;
+
+	return *keys;
+}
+
+void FEnemyBlackboardKeys::Resolve(const UBlackboardData& asset)
+{
+	movingState = asset.GetKeyID("MovingState");
+	distance = asset.GetKeyID("Distance");
+	deltaTime = asset.GetKeyID("DeltaTime");
+	safePlayerDistanceMin = asset.GetKeyID("safePlayerDistanceMin");
+	safePlayerDistanceMax = asset.GetKeyID("safePlayerDistanceMax");
+	playerActor = asset.GetKeyID("PlayerActor");
+	currentTarget = asset.GetKeyID("currentTarget");
+}
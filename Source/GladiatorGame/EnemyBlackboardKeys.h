@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Enum.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+
+class UBlackboardData;
+
+/**
+ * Key IDs of the enemy blackboard, resolved once per blackboard asset.
+ * Use them with UBlackboardComponent::GetValue/SetValue to skip the by-name key search.
+ */
+struct GLADIATORGAME_API FEnemyBlackboardKeys
+{
+	FBlackboard::FKey movingState = FBlackboard::InvalidKey;
+	FBlackboard::FKey distance = FBlackboard::InvalidKey;
+	FBlackboard::FKey deltaTime = FBlackboard::InvalidKey;
+	FBlackboard::FKey safePlayerDistanceMin = FBlackboard::InvalidKey;
+	FBlackboard::FKey safePlayerDistanceMax = FBlackboard::InvalidKey;
+	FBlackboard::FKey playerActor = FBlackboard::InvalidKey;
+	FBlackboard::FKey currentTarget = FBlackboard::InvalidKey;
+
+	static const FEnemyBlackboardKeys& Get(const UBlackboardComponent& blackboard);
+	static const FEnemyBlackboardKeys& Get(const UBlackboardData* asset);
+
+private:
+	void Resolve(const UBlackboardData& asset);
+};
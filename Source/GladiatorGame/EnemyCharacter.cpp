@@ -4,12 +4,15 @@
 #include "EnemyCharacter.h"
 #include "LifeComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "PlayerCharacter.h"
 #include "Kismet/GameplayStatics.h"
 #include "AIC_Enemy.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "AIEnemyManager.h"
 #include "GladiatorGameState.h"
+#include "GladiatorSpatialSubsystem.h"
+#include "GameFramework/CharacterMovementComponent.h"
 
 
 AEnemyCharacter::AEnemyCharacter()
@@ -17,6 +20,11 @@ AEnemyCharacter::AEnemyCharacter()
 {
 	healthComponent->SetLife(3);
 	healthComponent->invicibleCooldown = 0.5f;
+
+	// Far away or small on screen, the meshes animate at a lower rate
+	GetMesh()->bEnableUpdateRateOptimizations = true;
+	hammer->bEnableUpdateRateOptimizations = true;
+	shield->bEnableUpdateRateOptimizations = true;
 }
 
 void AEnemyCharacter::BeginPlay()
@@ -25,6 +33,28 @@ void AEnemyCharacter::BeginPlay()
 
 	healthComponent->OnKill.AddDynamic(this, &AEnemyCharacter::OnDeathEnemy);
 	playerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetActorOfClass(GetWorld(), APlayerCharacter::StaticClass()));
+
+	defaultAnimTickOption = GetMesh()->VisibilityBasedAnimTickOption;
+}
+
+void AEnemyCharacter::ApplySignificance(EEnemySignificance newSignificance, float tickInterval)
+{
+	significance = newSignificance;
+
+	SetActorTickInterval(tickInterval);
+	if (AController* controller = GetController())
+		controller->SetActorTickInterval(tickInterval);
+
+	for (USkeletalMeshComponent* mesh : { GetMesh(), hammer, shield })
+		mesh->SetComponentTickInterval(tickInterval);
+
+	const bool low = significance == EEnemySignificance::LOW;
+
+	GetMesh()->VisibilityBasedAnimTickOption = low ? EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered : defaultAnimTickOption;
+
+	// Nothing overlaps an enemy that far from the fight, the attacker is never low
+	GetCapsuleComponent()->SetGenerateOverlapEvents(!low);
+	GetMesh()->SetGenerateOverlapEvents(!low);
 }
 
 void AEnemyCharacter::OnDeathEnemy()
@@ -33,14 +63,14 @@ void AEnemyCharacter::OnDeathEnemy()
 
 	if (enemyController)
 	{
-		int enumId = enemyController->GetBlackboardComponent()->GetValueAsEnum("MovingState");
+		// Dying during an attack hands the turn back to the manager on the way out
+		enemyController->HandleEvent(EEnemyAIEvent::KILLED);
 
-		if (enumId == 6 || enumId == 7)
-			enemyController->AttackTerminated();
+		// The ragdoll is no longer looked after by the manager, keep it at full rate
+		ApplySignificance(EEnemySignificance::HIGH, 0.f);
 
-		enemyController->GetBlackboardComponent()->SetValueAsEnum("MovingState", 8);
-
-		enemyController->aiEnemyManager->DeleteEnemy(enemyController);
+		if (enemyController->aiEnemyManager)
+			enemyController->aiEnemyManager->DeleteEnemy(enemyController);
 	}
 
 	AGladiatorGameState* gameState = Cast<AGladiatorGameState>(GetWorld()->GetGameState());
@@ -51,6 +81,55 @@ void AEnemyCharacter::OnDeathEnemy()
 	}
 }
 
+void AEnemyCharacter::Sleep()
+{
+	AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(GetController());
+
+	// Prewarmed enemies sleep without dying, they leave what OnDeath would have left
+	if (isAlive())
+	{
+		characterState = ECharacterState::DEAD;
+		GetCharacterMovement()->Deactivate();
+
+		if (enemyController && enemyController->aiEnemyManager)
+			enemyController->aiEnemyManager->DeleteEnemy(enemyController);
+
+		if (UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>())
+			spatial->Unregister(this);
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	GetMesh()->SetSimulatePhysics(false);
+	hammer->SetSimulatePhysics(false);
+	shield->SetSimulatePhysics(false);
+
+	for (USkeletalMeshComponent* mesh : { GetMesh(), hammer, shield })
+		mesh->SetComponentTickEnabled(false);
+
+	if (enemyController)
+		enemyController->Sleep();
+}
+
+void AEnemyCharacter::Revive()
+{
+	Super::Revive();
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	for (USkeletalMeshComponent* mesh : { GetMesh(), hammer, shield })
+		mesh->SetComponentTickEnabled(true);
+
+	ApplySignificance(EEnemySignificance::HIGH, 0.f);
+
+	if (AAIC_Enemy* enemyController = Cast<AAIC_Enemy>(GetController()))
+		enemyController->Wake();
+}
+
 void AEnemyCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
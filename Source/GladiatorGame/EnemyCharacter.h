@@ -4,8 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "GladiatorGameCharacter.h"
+#include "Components/SkinnedMeshComponent.h"
 #include "EnemyCharacter.generated.h"
 
+/** How much an enemy matters to the player, picked each frame by AAIEnemyManager */
+enum class EEnemySignificance : uint8
+{
+	HIGH,
+	MEDIUM,
+	LOW
+};
+
 /**
  * 
  */
@@ -22,6 +31,16 @@ public :
 	
 	UCapsuleComponent* capsuleComponent;
 
+	EEnemySignificance GetSignificance() const { return significance; }
+
+	/** Ticks the actor, its controller and its meshes every tickInterval, low significance also stops overlaps and unseen animation */
+	void ApplySignificance(EEnemySignificance newSignificance, float tickInterval);
+
+	/** Hides the enemy and stops everything it runs, its controller included, until Revive */
+	void Sleep();
+
+	virtual void Revive() override;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
@@ -38,4 +57,7 @@ public :
 
 private :
 	class APlayerCharacter* playerCharacter;
+
+	EEnemySignificance significance = EEnemySignificance::HIGH;
+	EVisibilityBasedAnimTickOption defaultAnimTickOption;
 };
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyMovingState.generated.h"
+
+/** Values match the MovingState blackboard key */
+UENUM(BlueprintType)
+enum class EEnemyMovingState : uint8 {
+	IDLE		UMETA(DisplayName = "Idle"),
+	CHASING		UMETA(DisplayName = "Chasing"),
+	REPLACING	UMETA(DisplayName = "Replacing"),
+	PLACING		UMETA(DisplayName = "Placing"),
+	PLACED		UMETA(DisplayName = "Placed"),
+	GOING_BACK	UMETA(DisplayName = "Going Back"),
+	ATTACK		UMETA(DisplayName = "Attack"),
+	ATTACKING	UMETA(DisplayName = "Attacking"),
+	DEAD		UMETA(DisplayName = "Dead"),
+	COUNT		UMETA(Hidden)
+};
+
+inline bool IsAttackState(EEnemyMovingState state)
+{
+	return state == EEnemyMovingState::ATTACK || state == EEnemyMovingState::ATTACKING;
+}
+
+/** Inputs of the enemy state machine, see the transition table in AIC_Enemy.cpp */
+enum class EEnemyAIEvent : uint8 {
+	PLAYER_OUT_OF_RANGE,
+	PLAYER_STOPPED,
+	NEEDS_PLACE,
+	PLACE_CHOSEN,
+	PLACE_REACHED,
+	TOO_CLOSE,
+	BACK_IN_RANGE,
+	ATTACK_ORDERED,
+	ATTACK_STARTED,
+	ATTACK_TERMINATED,
+	KILLED,
+	COUNT
+};
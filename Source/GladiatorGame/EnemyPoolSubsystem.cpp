@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyPoolSubsystem.h"
+#include "EnemyCharacter.h"
+
+void UEnemyPoolSubsystem::Prewarm(TSubclassOf<AEnemyCharacter> enemyClass, int32 count)
+{
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const FTransform holdingTransform(holdingLocation);
+
+	FPooledEnemies& pool = pools.FindOrAdd(enemyClass);
+	pool.enemies.Reserve(pool.enemies.Num() + count);
+
+	for (int32 i = 0; i < count; i++)
+	{
+		AEnemyCharacter* enemy = GetWorld()->SpawnActor<AEnemyCharacter>(enemyClass, holdingTransform, spawnParams);
+		if (!enemy)
+			continue;
+
+		if (!enemy->GetController())
+			enemy->SpawnDefaultController();
+
+		Release(enemy);
+	}
+}
+
+AEnemyCharacter* UEnemyPoolSubsystem::Spawn(TSubclassOf<AEnemyCharacter> enemyClass, const FTransform& transform)
+{
+	FPooledEnemies* pool = pools.Find(enemyClass);
+	if (pool && pool->enemies.Num() > 0)
+	{
+		AEnemyCharacter* enemy = pool->enemies.Pop(false);
+		enemy->SetActorLocationAndRotation(transform.GetLocation(), transform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+		enemy->Revive();
+		return enemy;
+	}
+
+	FActorSpawnParameters spawnParams;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AEnemyCharacter* enemy = GetWorld()->SpawnActor<AEnemyCharacter>(enemyClass, transform, spawnParams);
+	if (enemy && !enemy->GetController())
+		enemy->SpawnDefaultController();
+
+	return enemy;
+}
+
+void UEnemyPoolSubsystem::Release(AEnemyCharacter* enemy)
+{
+	enemy->Sleep();
+	pools.FindOrAdd(enemy->GetClass()).enemies.Add(enemy);
+}
+
+int32 UEnemyPoolSubsystem::GetPooledCount(TSubclassOf<AEnemyCharacter> enemyClass) const
+{
+	const FPooledEnemies* pool = pools.Find(enemyClass);
+	return pool ? pool->enemies.Num() : 0;
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AEnemyCharacter;
+
+USTRUCT()
+struct FPooledEnemies
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AEnemyCharacter*> enemies;
+};
+
+/**
+ * Keeps dead enemies with their controllers instead of destroying them, and hands them out again as new spawns.
+ * Dead enemies come back through UCorpseSubsystem once their ragdoll is frozen.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Sleeping enemies by class */
+	UPROPERTY()
+	TMap<UClass*, FPooledEnemies> pools;
+
+public:
+	/** Where prewarmed enemies are spawned, out of the arena so they never overlap anything in it */
+	UPROPERTY(config)
+	FVector holdingLocation = FVector(0.f, 0.f, -50000.f);
+
+	/** Spawns count sleeping enemies ahead of a wave, so the wave itself creates no objects */
+	void Prewarm(TSubclassOf<AEnemyCharacter> enemyClass, int32 count);
+
+	/** A sleeping enemy of that class if there is one, a new one otherwise */
+	AEnemyCharacter* Spawn(TSubclassOf<AEnemyCharacter> enemyClass, const FTransform& transform);
+
+	/** Puts the enemy to sleep until a Spawn of its class */
+	void Release(AEnemyCharacter* enemy);
+
+	int32 GetPooledCount(TSubclassOf<AEnemyCharacter> enemyClass) const;
+};
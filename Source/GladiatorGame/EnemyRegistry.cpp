@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemyRegistry.h"
+
+FEnemyHandle FEnemyRegistry::Add(AAIC_Enemy* enemy)
+{
+	int32 slotIndex;
+	if (freeSlots.Num() > 0)
+		slotIndex = freeSlots.Pop(false);
+	else
+		slotIndex = slots.AddDefaulted();
+
+	FSlot& slot = slots[slotIndex];
+	slot.denseIndex = enemies.Add(enemy);
+	denseToSlot.Add(slotIndex);
+
+	FEnemyHandle handle;
+	handle.index = slotIndex;
+	handle.generation = slot.generation;
+	return handle;
+}
+
+bool FEnemyRegistry::Remove(FEnemyHandle handle)
+{
+	if (!Get(handle))
+		return false;
+
+	FSlot& slot = slots[handle.index];
+	const int32 denseIndex = slot.denseIndex;
+	const int32 lastIndex = enemies.Num() - 1;
+
+	// Move the last enemy into the hole and point its slot at its new place
+	if (denseIndex != lastIndex)
+	{
+		const int32 movedSlot = denseToSlot[lastIndex];
+		enemies[denseIndex] = enemies[lastIndex];
+		denseToSlot[denseIndex] = movedSlot;
+		slots[movedSlot].denseIndex = denseIndex;
+	}
+
+	enemies.Pop(false);
+	denseToSlot.Pop(false);
+
+	// Any handle still naming this slot stops resolving
+	slot.denseIndex = INDEX_NONE;
+	slot.generation++;
+	freeSlots.Add(handle.index);
+
+	return true;
+}
+
+AAIC_Enemy* FEnemyRegistry::Get(FEnemyHandle handle) const
+{
+	if (!slots.IsValidIndex(handle.index))
+		return nullptr;
+
+	const FSlot& slot = slots[handle.index];
+	if (slot.generation != handle.generation || slot.denseIndex == INDEX_NONE)
+		return nullptr;
+
+	return enemies[slot.denseIndex];
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyRegistry.generated.h"
+
+class AAIC_Enemy;
+
+/** Names an enemy in FEnemyRegistry, stops resolving once that enemy is removed even if its slot is reused */
+struct FEnemyHandle
+{
+	int32 index = INDEX_NONE;
+	uint32 generation = 0;
+
+	bool IsSet() const { return index != INDEX_NONE; }
+
+	bool operator==(const FEnemyHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const FEnemyHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * Slot map of the enemies, add and remove are O(1) and the enemies stay packed for iteration.
+ * Removing swaps the last enemy into the hole, the order of the enemies is not kept.
+ */
+USTRUCT()
+struct GLADIATORGAME_API FEnemyRegistry
+{
+	GENERATED_BODY()
+
+	FEnemyHandle Add(AAIC_Enemy* enemy);
+
+	/** Returns false if the handle was already stale */
+	bool Remove(FEnemyHandle handle);
+
+	/** nullptr once the enemy is removed */
+	AAIC_Enemy* Get(FEnemyHandle handle) const;
+
+	int32 Num() const { return enemies.Num(); }
+	AAIC_Enemy* operator[](int32 index) const { return enemies[index]; }
+
+	TArray<AAIC_Enemy*>::RangedForConstIteratorType begin() const { return enemies.begin(); }
+	TArray<AAIC_Enemy*>::RangedForConstIteratorType end() const { return enemies.end(); }
+
+private:
+	struct FSlot
+	{
+		int32 denseIndex = INDEX_NONE;
+		uint32 generation = 0;
+	};
+
+	UPROPERTY(VisibleInstanceOnly, Category = Registry)
+	TArray<AAIC_Enemy*> enemies;
+
+	/** Slot of each packed enemy, to fix the slot of the one swapped on removal */
+	TArray<int32> denseToSlot;
+
+	TArray<FSlot> slots;
+	TArray<int32> freeSlots;
+};
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "EnemySnapshot.h"
+
+void FEnemySnapshot::Reset(int32 expectedNum)
+{
+	positionsX.Reset(expectedNum);
+	positionsY.Reset(expectedNum);
+	positionsZ.Reset(expectedNum);
+	radii.Reset(expectedNum);
+	halfHeights.Reset(expectedNum);
+	placed.Reset(expectedNum);
+	pawns.Reset(expectedNum);
+	distances.Reset(expectedNum);
+
+	maxRadius = 0.f;
+}
+
+void FEnemySnapshot::Add(const APawn* pawn, const FVector& location, float radius, float halfHeight, bool isPlaced)
+{
+	positionsX.Add(location.X);
+	positionsY.Add(location.Y);
+	positionsZ.Add(location.Z);
+	radii.Add(radius);
+	halfHeights.Add(halfHeight);
+	placed.Add(isPlaced);
+	pawns.Add(pawn);
+
+	maxRadius = FMath::Max(maxRadius, radius);
+}
+
+void FEnemySnapshot::Finalize()
+{
+	grid.Build(positionsX.GetData(), positionsY.GetData(), Num());
+}
+
+void FEnemySnapshot::ComputeDistances(const FVector& target)
+{
+	const int32 count = Num();
+	distances.SetNumUninitialized(count, false);
+
+	const float* RESTRICT xs = positionsX.GetData();
+	const float* RESTRICT ys = positionsY.GetData();
+	const float* RESTRICT zs = positionsZ.GetData();
+	float* RESTRICT ds = distances.GetData();
+
+	for (int32 i = 0; i < count; i++)
+	{
+		const float dx = xs[i] - target.X;
+		const float dy = ys[i] - target.Y;
+		const float dz = zs[i] - target.Z;
+		ds[i] = FMath::Sqrt(dx * dx + dy * dy + dz * dz);
+	}
+}
+
+float FEnemySnapshot::DistanceSquaredToCapsule(int32 index, const FVector& point) const
+{
+	// Closest point on the vertical segment of the capsule
+	const float segmentHalf = FMath::Max(halfHeights[index] - radii[index], 0.f);
+	const float z = FMath::Clamp(point.Z, positionsZ[index] - segmentHalf, positionsZ[index] + segmentHalf);
+
+	return FMath::Square(point.X - positionsX[index]) + FMath::Square(point.Y - positionsY[index]) + FMath::Square(point.Z - z);
+}
+
+bool FEnemySnapshot::IsPlacedEnemyInSphere(const FVector& center, float radius, const APawn* ignoredPawn) const
+{
+	bool found = false;
+
+	grid.ForEachInRadius(center, radius + maxRadius, [&](int32 index)
+	{
+		if (found || !placed[index] || pawns[index] == ignoredPawn)
+			return;
+
+		const float reach = radius + radii[index];
+		if (DistanceSquaredToCapsule(index, center) <= reach * reach)
+			found = true;
+	});
+
+	return found;
+}
+
+bool FEnemySnapshot::IsSegmentBlockedByPlaced(const FVector& start, const FVector& end, const APawn* ignoredPawn) const
+{
+	const FVector dir = end - start;
+	const float dirLengthSquared = dir.SizeSquared();
+	const float invDirLengthSquared = dirLengthSquared > KINDA_SMALL_NUMBER ? 1.f / dirLengthSquared : 0.f;
+
+	const float* RESTRICT xs = positionsX.GetData();
+	const float* RESTRICT ys = positionsY.GetData();
+	const float* RESTRICT zs = positionsZ.GetData();
+	const float* RESTRICT rs = radii.GetData();
+	const float* RESTRICT hs = halfHeights.GetData();
+	const bool* RESTRICT ps = placed.GetData();
+
+	// Branch free over blocks of enemies so the compiler can vectorize, hits are confirmed one by one afterwards
+	constexpr int32 blockSize = 8;
+	const int32 count = Num();
+
+	for (int32 blockStart = 0; blockStart < count; blockStart += blockSize)
+	{
+		const int32 blockEnd = FMath::Min(blockStart + blockSize, count);
+		bool hits[blockSize];
+		bool anyHit = false;
+
+		for (int32 i = blockStart; i < blockEnd; i++)
+		{
+			// Closest points of the segment and the capsule axis, in 3D so slopes between the two ends are handled
+			const float segmentHalf = FMath::Max(hs[i] - rs[i], 0.f);
+			const float axisLength = 2.f * segmentHalf;
+			const float axisLengthSquared = axisLength * axisLength;
+			const float invAxisLengthSquared = axisLengthSquared > KINDA_SMALL_NUMBER ? 1.f / axisLengthSquared : 0.f;
+
+			const float rx = start.X - xs[i];
+			const float ry = start.Y - ys[i];
+			const float rz = start.Z - (zs[i] - segmentHalf);
+
+			const float b = axisLength * dir.Z;
+			const float c = dir.X * rx + dir.Y * ry + dir.Z * rz;
+			const float f = axisLength * rz;
+			const float denominator = dirLengthSquared * axisLengthSquared - b * b;
+
+			// s along the segment, t along the axis, s is fixed again when t has to be clamped
+			float s = invAxisLengthSquared > 0.f && denominator > KINDA_SMALL_NUMBER ? FMath::Clamp((b * f - c * axisLengthSquared) / denominator, 0.f, 1.f) : FMath::Clamp(-c * invDirLengthSquared, 0.f, 1.f);
+			const float tUnclamped = (b * s + f) * invAxisLengthSquared;
+			const float t = FMath::Clamp(tUnclamped, 0.f, 1.f);
+			s = tUnclamped < 0.f ? FMath::Clamp(-c * invDirLengthSquared, 0.f, 1.f) : (tUnclamped > 1.f ? FMath::Clamp((b - c) * invDirLengthSquared, 0.f, 1.f) : s);
+
+			const float dx = rx + dir.X * s;
+			const float dy = ry + dir.Y * s;
+			const float dz = rz + dir.Z * s - axisLength * t;
+
+			const float distanceSquared = dx * dx + dy * dy + dz * dz;
+			const bool hit = ps[i] & (distanceSquared <= rs[i] * rs[i]);
+
+			hits[i - blockStart] = hit;
+			anyHit |= hit;
+		}
+
+		if (!anyHit)
+			continue;
+
+		for (int32 i = blockStart; i < blockEnd; i++)
+		{
+			if (hits[i - blockStart] && pawns[i] != ignoredPawn)
+				return true;
+		}
+	}
+
+	return false;
+}
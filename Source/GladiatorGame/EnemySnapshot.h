@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpatialHashGrid.h"
+
+class APawn;
+
+/**
+ * Per frame copy of the registered enemies, stored as parallel arrays.
+ * Queries read it instead of asking the physics scene.
+ */
+struct GLADIATORGAME_API FEnemySnapshot
+{
+	TArray<float> positionsX;
+	TArray<float> positionsY;
+	TArray<float> positionsZ;
+	TArray<float> radii;
+	TArray<float> halfHeights;
+	TArray<bool> placed;
+	TArray<const APawn*> pawns;
+
+	/** Distance of each enemy to the target given to ComputeDistances */
+	TArray<float> distances;
+
+	float maxRadius = 0.f;
+
+	FSpatialHashGrid grid;
+
+	int32 Num() const { return pawns.Num(); }
+
+	void Reset(int32 expectedNum);
+	void Add(const APawn* pawn, const FVector& location, float radius, float halfHeight, bool isPlaced);
+
+	/** Buckets the added enemies, call once all of them are in */
+	void Finalize();
+
+	/** Fills distances in one pass over the positions */
+	void ComputeDistances(const FVector& target);
+
+	/** Is a placed enemy other than ignoredPawn touching the sphere */
+	bool IsPlacedEnemyInSphere(const FVector& center, float radius, const APawn* ignoredPawn) const;
+
+	/** Does the segment cross the capsule of a placed enemy other than ignoredPawn, capsules are assumed upright and tested in 3D */
+	bool IsSegmentBlockedByPlaced(const FVector& start, const FVector& end, const APawn* ignoredPawn) const;
+
+private:
+	float DistanceSquaredToCapsule(int32 index, const FVector& point) const;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FlickerSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice countMIDsCommand(
+		TEXT("gladiator.CountMIDs"),
+		TEXT("Prints how many dynamic material instances the world holds"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& args, UWorld* world, FOutputDevice& ar)
+		{
+			int32 count = 0;
+			for (TObjectIterator<UMaterialInstanceDynamic> it; it; ++it)
+			{
+				if (it->GetWorld() == world)
+					count++;
+			}
+
+			ar.Logf(TEXT("%d dynamic material instances"), count);
+		}));
+}
+
+void UFlickerSubsystem::Apply(UPrimitiveComponent* component, const FLinearColor& color) const
+{
+	if (useCustomPrimitiveData)
+		component->SetCustomPrimitiveDataVector4(customDataIndex, FVector4(color));
+	else
+		component->SetVectorParameterValueOnMaterials(TEXT("FlickerColor"), FVector(color));
+}
+
+void UFlickerSubsystem::SetFlicker(UPrimitiveComponent* component, const FLinearColor& color, float pulseRate, float duration)
+{
+	if (!component)
+		return;
+
+	FFlicker* flicker = flickers.FindByPredicate([component](const FFlicker& other) { return other.component == component; });
+	if (!flicker)
+	{
+		flicker = &flickers.AddDefaulted_GetRef();
+		flicker->component = component;
+	}
+
+	flicker->color = color;
+
+	// A pulse through the parameter would write every material slot every frame, the fallback stays steady
+	flicker->pulseRate = useCustomPrimitiveData ? pulseRate : 0.f;
+	flicker->endTime = duration > 0.f ? GetWorld()->GetTimeSeconds() + duration : -1.f;
+
+	Apply(component, color);
+}
+
+void UFlickerSubsystem::ClearFlicker(UPrimitiveComponent* component)
+{
+	const int32 index = flickers.IndexOfByPredicate([component](const FFlicker& other) { return other.component == component; });
+	if (index == INDEX_NONE)
+		return;
+
+	flickers.RemoveAtSwap(index, 1, false);
+	Apply(component, FLinearColor::Black);
+}
+
+void UFlickerSubsystem::Tick(float DeltaTime)
+{
+	const float time = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = flickers.Num() - 1; i >= 0; i--)
+	{
+		const FFlicker& flicker = flickers[i];
+
+		if (!IsValid(flicker.component))
+		{
+			flickers.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if (flicker.endTime >= 0.f && time >= flicker.endTime)
+		{
+			Apply(flicker.component, FLinearColor::Black);
+			flickers.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		// Steady colors were written once when set
+		if (flicker.pulseRate <= 0.f)
+			continue;
+
+		const float intensity = 0.5f + 0.5f * FMath::Cos(2.f * PI * flicker.pulseRate * time);
+		Apply(flicker.component, flicker.color * intensity);
+	}
+}
+
+ETickableTickType UFlickerSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UFlickerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlickerSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FlickerSubsystem.generated.h"
+
+USTRUCT()
+struct FFlicker
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UPrimitiveComponent* component = nullptr;
+
+	FLinearColor color = FLinearColor::Black;
+
+	/** Pulses per second, 0 for a steady color */
+	float pulseRate = 0.f;
+
+	/** Negative until cleared */
+	float endTime = -1.f;
+};
+
+/**
+ * Drives the FlickerColor of the gladiators' materials and animates the pulsing ones each frame.
+ * With useCustomPrimitiveData the color goes through custom primitive data 0-3 and the gladiators share their materials.
+ * Otherwise it sets the FlickerColor parameter, which makes a dynamic material instance per slot, and does not pulse.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UFlickerSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FFlicker> flickers;
+
+	void Apply(UPrimitiveComponent* component, const FLinearColor& color) const;
+
+public:
+	/** The FlickerColor parameter of the gladiator and hammer materials uses custom primitive data, off for materials that do not */
+	UPROPERTY(config)
+	bool useCustomPrimitiveData = true;
+
+	/** First custom primitive data index of the color */
+	UPROPERTY(config)
+	int customDataIndex = 0;
+
+	/** duration of 0 or less keeps it on until ClearFlicker, pulseRate only applies with custom primitive data */
+	void SetFlicker(UPrimitiveComponent* component, const FLinearColor& color, float pulseRate = 0.f, float duration = 0.f);
+	void ClearFlicker(UPrimitiveComponent* component);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return flickers.Num() > 0; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	virtual TStatId GetStatId() const override;
+};
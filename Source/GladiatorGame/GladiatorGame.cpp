@@ -3,5 +3,7 @@
 #include "GladiatorGame.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogGladiatorAI);
+DEFINE_LOG_CATEGORY(LogGladiator);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, GladiatorGame, "GladiatorGame" );
- 
\ No newline at end of file
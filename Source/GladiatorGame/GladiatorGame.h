@@ -3,3 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+/** Enemy AI decisions, anything under Warning is compiled out of Shipping and Test builds */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+DECLARE_LOG_CATEGORY_EXTERN(LogGladiatorAI, Warning, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogGladiatorAI, Log, All);
+#endif
+
+/** Gameplay outside the AI */
+DECLARE_LOG_CATEGORY_EXTERN(LogGladiator, Log, All);
@@ -12,6 +12,12 @@
 #include "GameFramework/Controller.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "LifeComponent.h"
+#include "GladiatorSpatialSubsystem.h"
+#include "GladiatorStats.h"
+#include "WeaponTraceComponent.h"
+#include "CombatSubsystem.h"
+#include "FlickerSubsystem.h"
+#include "CorpseSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -26,7 +32,6 @@ AGladiatorGameCharacter::AGladiatorGameCharacter()
 	GetCapsuleComponent()->SetCollisionProfileName(TEXT("PawnIgnoreCam"));
 
 	GetMesh()->SetCollisionProfileName(TEXT("CharacterMeshIgnoreCam"));
-	GetMesh()->SetVectorParameterValueOnMaterials("FlickerColor", FVector(0.f, 0.f, 0.f));
 
 	// Configure character movement
 	GetCharacterMovement()->bOrientRotationToMovement = true; // Character moves in the direction of input...	
@@ -51,7 +56,10 @@ AGladiatorGameCharacter::AGladiatorGameCharacter()
 
 	attackCollider = CreateDefaultSubobject<USphereComponent>(TEXT("WeaponCollider"));
 	attackCollider->SetupAttachment(hammer, TEXT("ColliderSocket"));
-	attackCollider->SetGenerateOverlapEvents(true);
+	attackCollider->SetGenerateOverlapEvents(false);
+	attackCollider->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	weaponTrace = CreateDefaultSubobject<UWeaponTraceComponent>(TEXT("WeaponTrace"));
 
 	shield = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Shield"));
 	shield->SetupAttachment(GetMesh(), TEXT("DualWeaponPoint"));
@@ -66,35 +74,58 @@ void AGladiatorGameCharacter::BeginPlay()
 	if (attackCollider)
 	{
 		attackCollider->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		attackCollider->OnComponentBeginOverlap.AddDynamic(this, &AGladiatorGameCharacter::OverlapCallback);
+
+		weaponTrace->SetTracedComponent(attackCollider);
+		weaponTrace->radius = attackCollider->GetScaledSphereRadius();
+		weaponTrace->OnWeaponHit.AddUObject(this, &AGladiatorGameCharacter::OnWeaponHit);
 	}
 
+	initialLife = healthComponent ? healthComponent->GetLife() : 0;
+	meshRelativeTransform = GetMesh()->GetRelativeTransform();
+	meshCollisionProfile = GetMesh()->GetCollisionProfileName();
+	weaponCollisionProfile = hammer->GetCollisionProfileName();
+
+	// The collider follows the hand rather than the hammer, which is not registered while shown as a static mesh
+	if (attackCollider)
+		attackCollider->AttachToComponent(GetMesh(), FAttachmentTransformRules::KeepWorldTransform, hammer->GetAttachSocketName());
+
+	hammerAttachment.Init(hammer);
+	shieldAttachment.Init(shield);
+
 	if (healthComponent)
 	{
 		healthComponent->OnHurt.AddDynamic(this, &AGladiatorGameCharacter::OnHurt);
 		healthComponent->OnKill.AddDynamic(this, &AGladiatorGameCharacter::OnDeath);
 		healthComponent->OnInvicibilityStop.AddDynamic(this, &AGladiatorGameCharacter::OnInvicibilityStop);
 	}
+
+	if (UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>())
+		spatial->Register(this);
 }
 
-void AGladiatorGameCharacter::OverlapCallback(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AGladiatorGameCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (!OverlappedComp || !OtherActor || OtherActor == this)
-		return;
+	if (UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>())
+		spatial->Unregister(this);
 
-	AGladiatorGameCharacter* other = Cast<AGladiatorGameCharacter>(OtherActor);
+	Super::EndPlay(EndPlayReason);
+}
 
-	if (other)
-		other->TakeDamage(1, GetActorLocation());
+void AGladiatorGameCharacter::OnWeaponHit(AActor* victim, const FHitResult& hit)
+{
+	AGladiatorGameCharacter* other = Cast<AGladiatorGameCharacter>(victim);
+	if (!other)
+		return;
+
+	// Resolved with the other hits of the frame, not in the middle of the sweep
+	if (UCombatSubsystem* combat = GetWorld()->GetSubsystem<UCombatSubsystem>())
+		combat->QueueDamage(this, other, 1);
 }
 
-void AGladiatorGameCharacter::TakeDamage(int damage, const FVector& senderPosition)
+bool AGladiatorGameCharacter::BlockHit(const FVector& senderPosition)
 {
 	if (characterState != ECharacterState::DEFENDING)
-	{
-		healthComponent->Hurt(1);
-		return;
-	}
+		return false;
 
 	DefendOff();
 
@@ -103,18 +134,26 @@ void AGladiatorGameCharacter::TakeDamage(int damage, const FVector& senderPositi
 	if (FVector::DotProduct(senderDirection, GetActorForwardVector()) > 0.25f)
 	{
 		setCameraShake(camShake, 1.f);
-		return;
+		return true;
 	}
 
-	healthComponent->Hurt(1);
+	return false;
 }
 
 void AGladiatorGameCharacter::SetAttackState(bool attacking)
 {
-	if (hammer)
-		hammer->SetVectorParameterValueOnMaterials("FlickerColor", attacking * FVector(0.9f, 0.f, 0.f));
+	if (UFlickerSubsystem* flicker = GetWorld()->GetSubsystem<UFlickerSubsystem>())
+	{
+		if (attacking)
+			flicker->SetFlicker(hammerAttachment.GetVisibleComponent(), FLinearColor(0.9f, 0.f, 0.f));
+		else
+			flicker->ClearFlicker(hammerAttachment.GetVisibleComponent());
+	}
 
-	attackCollider->SetCollisionEnabled(attacking ? ECollisionEnabled::QueryAndPhysics : ECollisionEnabled::NoCollision);
+	if (attacking)
+		weaponTrace->BeginSwing();
+	else
+		weaponTrace->EndSwing();
 }
 
 void AGladiatorGameCharacter::ActivateCamera() 
@@ -129,7 +168,8 @@ void AGladiatorGameCharacter::DeactivateCamera()
 
 void AGladiatorGameCharacter::OnInvicibilityStop()
 {
-	GetMesh()->SetVectorParameterValueOnMaterials("FlickerColor", FVector(0.f, 0.f, 0.f));
+	if (UFlickerSubsystem* flicker = GetWorld()->GetSubsystem<UFlickerSubsystem>())
+		flicker->ClearFlicker(GetMesh());
 }
 
 void AGladiatorGameCharacter::setCameraShake(const TSubclassOf<UCameraShakeBase>& shakeClass, float scale)
@@ -140,19 +180,24 @@ void AGladiatorGameCharacter::setCameraShake(const TSubclassOf<UCameraShakeBase>
 
 void AGladiatorGameCharacter::OnHurt()
 {
-	GetMesh()->SetVectorParameterValueOnMaterials("FlickerColor", FVector(1.f, 0.f, 0.f));
+	if (UFlickerSubsystem* flicker = GetWorld()->GetSubsystem<UFlickerSubsystem>())
+		flicker->SetFlicker(GetMesh(), FLinearColor::Red, hurtFlickerRate);
 
 	setCameraShake(camShake, 0.75f);
 }
 
 void AGladiatorGameCharacter::OnDeath()
 {
-	characterState = ECharacterState::DEAD;
+	if (UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>())
+		spatial->Unregister(this);
 
 	setCameraShake(camShake, 1.25f);
 
 	SetAttackState(false);
+
+	// Listeners drop the attack or the defence, the character itself stays DEAD until Revive
 	SetState(ECharacterState::IDLE);
+	characterState = ECharacterState::DEAD;
 
 	GetCharacterMovement()->Deactivate();
 
@@ -163,17 +208,77 @@ void AGladiatorGameCharacter::OnDeath()
 	GetMesh()->SetCollisionProfileName(TEXT("RagdollIgnoreCam"));
 	GetMesh()->SetSimulatePhysics(true);
 
-	hammer->DetachFromParent(true);
-	hammer->SetSimulatePhysics(true);
-	hammer->SetCollisionProfileName(TEXT("Props"));
+	hammerAttachment.Drop(TEXT("Props"));
+	shieldAttachment.Drop(TEXT("Props"));
 
-	shield->DetachFromParent(true);
-	shield->SetSimulatePhysics(true);
-	shield->SetCollisionProfileName(TEXT("Props"));
+	if (UCorpseSubsystem* corpses = GetWorld()->GetSubsystem<UCorpseSubsystem>())
+		corpses->AddCorpse(this);
+}
+
+bool AGladiatorGameCharacter::IsRagdollAsleep() const
+{
+	return !GetMesh()->IsAnyRigidBodyAwake() && !hammer->IsAnyRigidBodyAwake() && !shield->IsAnyRigidBodyAwake();
+}
+
+void AGladiatorGameCharacter::FreezeRagdoll(TFunctionRef<void(UStaticMesh* mesh, const FTransform& transform)> addProp)
+{
+	// The pose of the last simulated frame is kept as is, nothing updates the bones any more
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetMesh()->bNoSkeletonUpdate = true;
+	GetMesh()->SetComponentTickEnabled(false);
+
+	for (const FWeaponAttachment* attachment : { &hammerAttachment, &shieldAttachment })
+	{
+		USkeletalMeshComponent* weapon = attachment->GetSkeletalComponent();
+		weapon->SetSimulatePhysics(false);
+		weapon->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		weapon->bNoSkeletonUpdate = true;
+		weapon->SetComponentTickEnabled(false);
+
+		if (attachment->staticMesh)
+		{
+			addProp(attachment->staticMesh, weapon->GetComponentTransform());
+			weapon->SetVisibility(false);
+		}
+	}
+}
+
+void AGladiatorGameCharacter::Revive()
+{
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->bNoSkeletonUpdate = false;
+	GetMesh()->SetComponentTickEnabled(true);
+	GetMesh()->SetCollisionProfileName(meshCollisionProfile);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(meshRelativeTransform);
+
+	hammerAttachment.Reattach(weaponCollisionProfile);
+	shieldAttachment.Reattach(weaponCollisionProfile);
+
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->Activate();
+
+	if (UFlickerSubsystem* flicker = GetWorld()->GetSubsystem<UFlickerSubsystem>())
+	{
+		flicker->ClearFlicker(GetMesh());
+		flicker->ClearFlicker(hammerAttachment.GetVisibleComponent());
+	}
+
+	healthComponent->Revive(initialLife);
+	characterState = ECharacterState::IDLE;
+	SetState(ECharacterState::IDLE);
+
+	if (UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>())
+		spatial->Register(this);
 }
 
 void AGladiatorGameCharacter::SetState(ECharacterState state)
 {
+	// Animation notifies and blocked hits still reach a corpse, they do not bring it back
+	if (characterState == ECharacterState::DEAD)
+		return;
+
 	characterState = state;
 
 	if (OnStateChanged.IsBound())
@@ -237,44 +342,22 @@ void AGladiatorGameCharacter::Move(const FVector& direction, float value)
 
 AGladiatorGameCharacter* AGladiatorGameCharacter::GetOtherGladiator(float minDistance, float maxDistance)
 {
-	float minDistSquared = minDistance * minDistance;
-	float maxDistSquared = maxDistance * maxDistance;
-
-	FVector currentLocation = GetActorLocation();
-
-	TArray<AActor*> gladiators;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AGladiatorGameCharacter::StaticClass(), gladiators);
-
-	TArray<AGladiatorGameCharacter*> validGladiators;
-	for (AActor* actor : gladiators)
-	{
-		if (actor == this)
-			continue;
-		
-		float distSquared = GetSquaredDistanceTo(actor);
-
-		if (GetSquaredDistanceTo(actor) < minDistSquared || GetSquaredDistanceTo(actor) > maxDistSquared)
-			continue;
-
-		AGladiatorGameCharacter* gladiator = Cast<AGladiatorGameCharacter>(actor);
+	GLADIATOR_SCOPE(STAT_GladiatorGetOtherGladiator);
 
-		if (!gladiator->isAlive())
-			continue;
+	UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>();
+	if (!spatial)
+		return nullptr;
 
-		validGladiators.Add(gladiator);
-	}
+	return spatial->FindNearest(GetActorLocation(), minDistance, maxDistance, this);
+}
 
-	if (validGladiators.Num() == 0)
+AGladiatorGameCharacter* AGladiatorGameCharacter::GetNextGladiator(float minDistance, float maxDistance, const AGladiatorGameCharacter* current)
+{
+	UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>();
+	if (!spatial)
 		return nullptr;
 
-	validGladiators.Sort([this](const AGladiatorGameCharacter& A, const AGladiatorGameCharacter& B)
-	{
-		float distA = GetDistanceTo(&A);
-		float distB = GetDistanceTo(&B);
-		return distA < distB;
-	});
-
-	return validGladiators[0];
+	return spatial->FindNext(GetActorLocation(), minDistance, maxDistance, this, current);
 }
 
 void AGladiatorGameCharacter::LookAtTarget(AActor* target, float lookSpeed)
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "CharacterState.h"
+#include "WeaponAttachment.h"
 #include "Blueprint/UserWidget.h"
 #include "GladiatorGameCharacter.generated.h"
 
@@ -33,7 +34,16 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Mesh, meta = (AllowPrivateAccess = "true"))
 	class USkeletalMeshComponent* shield;
 
-	void TakeDamage(int damage, const FVector& senderPosition);
+	/** How hammer and shield are shown while alive, the skeletal meshes above are the props dropped on death */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Mesh, meta = (AllowPrivateAccess = "true"))
+	FWeaponAttachment hammerAttachment;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Mesh, meta = (AllowPrivateAccess = "true"))
+	FWeaponAttachment shieldAttachment;
+
+	/** Sweeps attackCollider's path during attacks, the collider itself no longer overlaps */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	class UWeaponTraceComponent* weaponTrace;
 
 public:
 	AGladiatorGameCharacter();
@@ -57,8 +67,7 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void SetAttackState(bool attacking);
 
-	UFUNCTION()
-	void OverlapCallback(class UPrimitiveComponent* OverlappedComp, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	void OnWeaponHit(AActor* victim, const FHitResult& hit);
 
 	void Move(EAxis::Type axis, float value);
 	void Move(const FVector& direction, float value);
@@ -66,6 +75,7 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = State, meta = (AllowPrivateAccess = "true"))
 	ECharacterState characterState = ECharacterState::IDLE;
 
+	/** Ignored once DEAD, only Revive leaves that state */
 	void SetState(ECharacterState state);
 
 	UFUNCTION(BlueprintCallable)
@@ -84,16 +94,32 @@ protected:
 	void MoveRight(float Value);
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	void setCameraShake(const TSubclassOf<UCameraShakeBase>& shakeClass, float scale);
 
 	UPROPERTY(EditAnywhere)
 	TSubclassOf<UMatineeCameraShake> camShake;
 
+	/** Pulses per second of the red flicker while invincible */
+	UPROPERTY(EditAnywhere, Category = Combat)
+	float hurtFlickerRate = 8.f;
+
 	AGladiatorGameCharacter* GetOtherGladiator(float minDistance, float maxDistance);
 
+	/** Next gladiator farther than current in the same range, the nearest one after the farthest */
+	AGladiatorGameCharacter* GetNextGladiator(float minDistance, float maxDistance, const AGladiatorGameCharacter* current);
+
 	void LookAtTarget(AActor* target, float lookSpeed);
 
+	/** Life the character starts with, given back by Revive */
+	int initialLife = 0;
+
+private:
+	FTransform meshRelativeTransform;
+	FName meshCollisionProfile;
+	FName weaponCollisionProfile;
+
 public:
 	bool canDefend() { return characterState == ECharacterState::IDLE || characterState == ECharacterState::ATTACKING; }
 	bool canAttack() { return characterState == ECharacterState::IDLE; }
@@ -106,6 +132,18 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual void Attack();
 
+	/** Defend check of a hit from senderPosition, true if the shield took it. Any hit ends the defence */
+	bool BlockHit(const FVector& senderPosition);
+
+	/** Undoes OnDeath, the ragdoll stops and the weapons go back in the hands */
+	virtual void Revive();
+
+	/** True once the ragdoll and the dropped weapons have all gone to sleep */
+	bool IsRagdollAsleep() const;
+
+	/** Stops the ragdoll in its current pose, addProp is given each dropped weapon with a static mesh, which is then hidden */
+	void FreezeRagdoll(TFunctionRef<void(class UStaticMesh* mesh, const FTransform& transform)> addProp);
+
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return cameraBoomComp; }
 	/** Returns FollowCamera subobject **/
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return followCameraComp; }	
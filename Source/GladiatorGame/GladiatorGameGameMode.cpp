@@ -3,6 +3,8 @@
 #include "GladiatorGameGameMode.h"
 #include "GladiatorGameCharacter.h"
 #include "GladiatorGameState.h"
+#include "EnemyCharacter.h"
+#include "EnemyPoolSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
 
 AGladiatorGameGameMode::AGladiatorGameGameMode()
@@ -19,4 +21,36 @@ AGladiatorGameGameMode::AGladiatorGameGameMode()
 	{
 		GameStateClass = AGameStateBPClass.Class;
 	}
+
+	static ConstructorHelpers::FClassFinder<AEnemyCharacter> EnemyBPClass(TEXT("/Game/Blueprints/Enemy/EnemyCharacter"));
+	if (EnemyBPClass.Class != NULL)
+	{
+		waveEnemyClass = EnemyBPClass.Class;
+	}
+}
+
+void AGladiatorGameGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	if (UEnemyPoolSubsystem* pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>())
+	{
+		if (waveEnemyClass && prewarmedEnemies > 0)
+			pool->Prewarm(waveEnemyClass, prewarmedEnemies);
+	}
+}
+
+AEnemyCharacter* AGladiatorGameGameMode::SpawnEnemy(const FTransform& transform)
+{
+	UEnemyPoolSubsystem* pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+	if (!pool || !waveEnemyClass)
+		return nullptr;
+
+	AEnemyCharacter* enemy = pool->Spawn(waveEnemyClass, transform);
+
+	AGladiatorGameState* gameState = GetGameState<AGladiatorGameState>();
+	if (enemy && gameState)
+		gameState->enemiesCount++;
+
+	return enemy;
 }
@@ -6,13 +6,29 @@
 #include "GameFramework/GameModeBase.h"
 #include "GladiatorGameGameMode.generated.h"
 
-UCLASS(minimalapi)
+class AEnemyCharacter;
+
+UCLASS(minimalapi, config = Game)
 class AGladiatorGameGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
 
 public:
 	AGladiatorGameGameMode();
+
+	/** Class of the enemies spawned during the match */
+	UPROPERTY(EditDefaultsOnly, Category = Enemies)
+	TSubclassOf<AEnemyCharacter> waveEnemyClass;
+
+	/** Sleeping enemies created when the match starts, a wave up to this size creates no objects. Set it for the maps that have waves */
+	UPROPERTY(config, EditDefaultsOnly, Category = Enemies)
+	int prewarmedEnemies = 0;
+
+	/** Spawns an enemy through the enemy pool, the game state counts it in the enemies left */
+	UFUNCTION(BlueprintCallable, Category = Enemies)
+	AEnemyCharacter* SpawnEnemy(const FTransform& transform);
+
+	virtual void StartPlay() override;
 };
 
 
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GladiatorSpatialSubsystem.h"
+#include "GladiatorStats.h"
+#include "GladiatorGameCharacter.h"
+
+void UGladiatorSpatialSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	grid.SetCellSize(cellSize);
+}
+
+void UGladiatorSpatialSubsystem::Register(AGladiatorGameCharacter* gladiator)
+{
+	if (indices.Contains(gladiator))
+		return;
+
+	indices.Add(gladiator, gladiators.Add(gladiator));
+	builtFrame = MAX_uint64;
+}
+
+void UGladiatorSpatialSubsystem::Unregister(AGladiatorGameCharacter* gladiator)
+{
+	int32 index;
+	if (!indices.RemoveAndCopyValue(gladiator, index))
+		return;
+
+	gladiators.RemoveAtSwap(index, 1, false);
+	if (gladiators.IsValidIndex(index))
+		indices[gladiators[index]] = index;
+
+	builtFrame = MAX_uint64;
+}
+
+void UGladiatorSpatialSubsystem::Refresh()
+{
+	if (builtFrame == GFrameCounter)
+		return;
+
+	GLADIATOR_SCOPE(STAT_GladiatorGridRebuild);
+
+	builtFrame = GFrameCounter;
+
+	const int32 count = gladiators.Num();
+	positionsX.SetNumUninitialized(count, false);
+	positionsY.SetNumUninitialized(count, false);
+	positionsZ.SetNumUninitialized(count, false);
+
+	for (int32 i = 0; i < count; i++)
+	{
+		const FVector location = gladiators[i]->GetActorLocation();
+		positionsX[i] = location.X;
+		positionsY[i] = location.Y;
+		positionsZ[i] = location.Z;
+	}
+
+	grid.Build(positionsX.GetData(), positionsY.GetData(), count);
+}
+
+AGladiatorGameCharacter* UGladiatorSpatialSubsystem::FindNearest(const FVector& center, float minDistance, float maxDistance, const AGladiatorGameCharacter* ignored)
+{
+	return FindNext(center, minDistance, maxDistance, ignored, nullptr);
+}
+
+AGladiatorGameCharacter* UGladiatorSpatialSubsystem::FindNext(const FVector& center, float minDistance, float maxDistance, const AGladiatorGameCharacter* ignored, const AGladiatorGameCharacter* current)
+{
+	Refresh();
+
+	const float minDistSquared = minDistance * minDistance;
+	const float maxDistSquared = maxDistance * maxDistance;
+
+	// Candidates are ordered by (distance, index) so gladiators at the same distance still cycle
+	float currentDistSquared = -1.f;
+	int32 currentIndex = INDEX_NONE;
+	const int32* currentEntry = current ? indices.Find(current) : nullptr;
+	if (currentEntry)
+	{
+		currentIndex = *currentEntry;
+		currentDistSquared = FVector::DistSquared(center, FVector(positionsX[currentIndex], positionsY[currentIndex], positionsZ[currentIndex]));
+	}
+
+	int32 nearest = INDEX_NONE, next = INDEX_NONE;
+	float nearestDistSquared = MAX_flt, nextDistSquared = MAX_flt;
+
+	grid.ForEachInRadius(center, maxDistance, [&](int32 i)
+	{
+		AGladiatorGameCharacter* gladiator = gladiators[i];
+		if (gladiator == ignored || gladiator == current || !IsAlive(gladiator))
+			return;
+
+		const float distSquared = FVector::DistSquared(center, FVector(positionsX[i], positionsY[i], positionsZ[i]));
+		if (distSquared < minDistSquared || distSquared > maxDistSquared)
+			return;
+
+		if (distSquared < nearestDistSquared || (distSquared == nearestDistSquared && i < nearest))
+		{
+			nearest = i;
+			nearestDistSquared = distSquared;
+		}
+
+		const bool isFarther = distSquared > currentDistSquared || (distSquared == currentDistSquared && i > currentIndex);
+		if (isFarther && (distSquared < nextDistSquared || (distSquared == nextDistSquared && i < next)))
+		{
+			next = i;
+			nextDistSquared = distSquared;
+		}
+	});
+
+	const int32 found = next != INDEX_NONE ? next : nearest;
+	return found != INDEX_NONE ? gladiators[found] : nullptr;
+}
+
+bool UGladiatorSpatialSubsystem::GetCachedLocation(const AGladiatorGameCharacter* gladiator, FVector& location)
+{
+	Refresh();
+
+	const int32* index = indices.Find(gladiator);
+	if (!index)
+		return false;
+
+	location = FVector(positionsX[*index], positionsY[*index], positionsZ[*index]);
+	return true;
+}
+
+bool UGladiatorSpatialSubsystem::IsAlive(AGladiatorGameCharacter* gladiator)
+{
+	return gladiator->isAlive();
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialHashGrid.h"
+#include "GladiatorSpatialSubsystem.generated.h"
+
+class AGladiatorGameCharacter;
+
+/**
+ * Positions of the living gladiators of the world, bucketed in a grid for range queries.
+ * Gladiators register on begin play and leave on death, the grid is rebuilt by the first query of a frame.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API UGladiatorSpatialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AGladiatorGameCharacter*> gladiators;
+
+	TArray<float> positionsX;
+	TArray<float> positionsY;
+	TArray<float> positionsZ;
+
+	/** Index of each gladiator in the arrays above */
+	TMap<const AGladiatorGameCharacter*, int32> indices;
+
+	FSpatialHashGrid grid;
+
+	/** Frame the grid was built on, cleared when the gladiators change */
+	uint64 builtFrame = MAX_uint64;
+
+	void Refresh();
+
+public:
+	UPROPERTY(config)
+	float cellSize = 500.f;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void Register(AGladiatorGameCharacter* gladiator);
+	void Unregister(AGladiatorGameCharacter* gladiator);
+
+	/** Closest living gladiator between minDistance and maxDistance of center, other than ignored */
+	AGladiatorGameCharacter* FindNearest(const FVector& center, float minDistance, float maxDistance, const AGladiatorGameCharacter* ignored);
+
+	/**
+	 * Closest gladiator farther than current, in the same range, to cycle targets outwards.
+	 * Wraps around to the nearest one once current is the farthest.
+	 */
+	AGladiatorGameCharacter* FindNext(const FVector& center, float minDistance, float maxDistance, const AGladiatorGameCharacter* ignored, const AGladiatorGameCharacter* current);
+
+	/** Position cached at the last rebuild, false if the gladiator is not registered */
+	bool GetCachedLocation(const AGladiatorGameCharacter* gladiator, FVector& location);
+
+	/** Calls func(gladiator, location, distSquared) for every living gladiator between minDistance and maxDistance of center */
+	template<typename FuncType>
+	void ForEachInRange(const FVector& center, float minDistance, float maxDistance, const AGladiatorGameCharacter* ignored, FuncType&& func)
+	{
+		Refresh();
+
+		const float minDistSquared = minDistance * minDistance;
+		const float maxDistSquared = maxDistance * maxDistance;
+
+		grid.ForEachInRadius(center, maxDistance, [&](int32 i)
+		{
+			AGladiatorGameCharacter* gladiator = gladiators[i];
+			if (gladiator == ignored || !IsAlive(gladiator))
+				return;
+
+			const FVector location(positionsX[i], positionsY[i], positionsZ[i]);
+			const float distSquared = FVector::DistSquared(center, location);
+			if (distSquared >= minDistSquared && distSquared <= maxDistSquared)
+				func(gladiator, location, distSquared);
+		});
+	}
+
+private:
+	static bool IsAlive(AGladiatorGameCharacter* gladiator);
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GladiatorStats.h"
+
+DEFINE_STAT(STAT_GladiatorManagerStep);
+DEFINE_STAT(STAT_GladiatorManagerTick);
+DEFINE_STAT(STAT_GladiatorSelectAttacker);
+DEFINE_STAT(STAT_GladiatorLaunchAttack);
+DEFINE_STAT(STAT_GladiatorEncirclement);
+DEFINE_STAT(STAT_GladiatorPlacementSolve);
+DEFINE_STAT(STAT_GladiatorGridRebuild);
+DEFINE_STAT(STAT_GladiatorGetOtherGladiator);
+DEFINE_STAT(STAT_GladiatorLockOn);
+DEFINE_STAT(STAT_GladiatorDamageResolution);
+DEFINE_STAT(STAT_GladiatorCorpses);
+
+DEFINE_STAT(STAT_GladiatorBTD_CheckAttack);
+DEFINE_STAT(STAT_GladiatorBTD_CheckAttackDistance);
+DEFINE_STAT(STAT_GladiatorBTD_CheckAttackState);
+DEFINE_STAT(STAT_GladiatorBTD_CheckDeath);
+DEFINE_STAT(STAT_GladiatorBTD_CheckMove);
+DEFINE_STAT(STAT_GladiatorBTD_CheckPlacing);
+DEFINE_STAT(STAT_GladiatorBTS_CheckPlayerDistance);
+DEFINE_STAT(STAT_GladiatorBTS_RotateService);
+DEFINE_STAT(STAT_GladiatorBTT_Attack);
+DEFINE_STAT(STAT_GladiatorBTT_AttackTerminated);
+DEFINE_STAT(STAT_GladiatorBTT_MoveToBack);
+DEFINE_STAT(STAT_GladiatorBTT_MoveToPlayer);
+DEFINE_STAT(STAT_GladiatorBTT_PlaceAroundPlayer);
+DEFINE_STAT(STAT_GladiatorBTT_RotateToPlayer);
+
+DEFINE_STAT(STAT_GladiatorPhysicsQueries);
+DEFINE_STAT(STAT_GladiatorNavProjections);
+DEFINE_STAT(STAT_GladiatorNavPathRequests);
+DEFINE_STAT(STAT_GladiatorBlackboardWrites);
+DEFINE_STAT(STAT_GladiatorDamageEvents);
+
+DEFINE_STAT(STAT_GladiatorSimulatingRagdolls);
+
+FThreadSafeCounter FGladiatorQueryCounters::physicsQueries;
+FThreadSafeCounter FGladiatorQueryCounters::navProjections;
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/ThreadSafeCounter.h"
+
+DECLARE_STATS_GROUP(TEXT("Gladiator"), STATGROUP_Gladiator, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Manager Step"), STAT_GladiatorManagerStep, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Manager Tick"), STAT_GladiatorManagerTick, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Select Attacker"), STAT_GladiatorSelectAttacker, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Launch Attack"), STAT_GladiatorLaunchAttack, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encirclement Update"), STAT_GladiatorEncirclement, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Placement Solve"), STAT_GladiatorPlacementSolve, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gladiator Grid Rebuild"), STAT_GladiatorGridRebuild, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetOtherGladiator"), STAT_GladiatorGetOtherGladiator, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lock-On Update"), STAT_GladiatorLockOn, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Resolution"), STAT_GladiatorDamageResolution, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Corpse Update"), STAT_GladiatorCorpses, STATGROUP_Gladiator, GLADIATORGAME_API);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckAttack"), STAT_GladiatorBTD_CheckAttack, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckAttackDistance"), STAT_GladiatorBTD_CheckAttackDistance, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckAttackState"), STAT_GladiatorBTD_CheckAttackState, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckDeath"), STAT_GladiatorBTD_CheckDeath, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckMove"), STAT_GladiatorBTD_CheckMove, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTD_CheckPlacing"), STAT_GladiatorBTD_CheckPlacing, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTS_CheckPlayerDistance"), STAT_GladiatorBTS_CheckPlayerDistance, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTS_RotateService"), STAT_GladiatorBTS_RotateService, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_Attack"), STAT_GladiatorBTT_Attack, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_AttackTerminated"), STAT_GladiatorBTT_AttackTerminated, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_MoveToBack"), STAT_GladiatorBTT_MoveToBack, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_MoveToPlayer"), STAT_GladiatorBTT_MoveToPlayer, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_PlaceAroundPlayer"), STAT_GladiatorBTT_PlaceAroundPlayer, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BTT_RotateToPlayer"), STAT_GladiatorBTT_RotateToPlayer, STATGROUP_Gladiator, GLADIATORGAME_API);
+
+/** Counters are cleared every frame, they read as per frame numbers in stat Gladiator */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics Queries"), STAT_GladiatorPhysicsQueries, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Projections"), STAT_GladiatorNavProjections, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nav Path Requests"), STAT_GladiatorNavPathRequests, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blackboard Writes"), STAT_GladiatorBlackboardWrites, STATGROUP_Gladiator, GLADIATORGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Damage Events"), STAT_GladiatorDamageEvents, STATGROUP_Gladiator, GLADIATORGAME_API);
+
+/** Accumulators keep the last value set */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Simulating Ragdolls"), STAT_GladiatorSimulatingRagdolls, STATGROUP_Gladiator, GLADIATORGAME_API);
+
+/** The same physics query and nav projection counts, readable without the stats system. The AI load test takes them every frame */
+struct GLADIATORGAME_API FGladiatorQueryCounters
+{
+	static FThreadSafeCounter physicsQueries;
+	static FThreadSafeCounter navProjections;
+};
+
+#define GLADIATOR_COUNT_PHYSICS_QUERIES(Amount) \
+	do { INC_DWORD_STAT_BY(STAT_GladiatorPhysicsQueries, Amount); FGladiatorQueryCounters::physicsQueries.Add(Amount); } while (0)
+
+#define GLADIATOR_COUNT_NAV_PROJECTIONS(Amount) \
+	do { INC_DWORD_STAT_BY(STAT_GladiatorNavProjections, Amount); FGladiatorQueryCounters::navProjections.Add(Amount); } while (0)
+
+/** Times the enclosing scope for stat Gladiator and names it in Insights captures, the trace part stays in builds without stats */
+#define GLADIATOR_SCOPE(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
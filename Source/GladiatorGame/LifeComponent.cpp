@@ -2,10 +2,11 @@
 
 
 #include "LifeComponent.h"
+#include "CombatSubsystem.h"
 
 void ULifeComponent::Hurt(int damage) 
 { 
-	if (isInvicible)
+	if (IsInvincible())
 		return;
 
 	SetLife(life - damage);
@@ -16,14 +17,22 @@ void ULifeComponent::Hurt(int damage)
 	if (invicibleCooldown <= 0.f)
 		return;
 
-	isInvicible = true;
-	GetWorld()->GetTimerManager().SetTimer(invicibleTimer, this, &ULifeComponent::ResetInvicibility, invicibleCooldown, false);
+	invincibleUntil = GetWorld()->GetTimeSeconds() + invicibleCooldown;
+
+	if (UCombatSubsystem* combat = GetWorld()->GetSubsystem<UCombatSubsystem>())
+		combat->AddCooldown(this, invincibleUntil);
 }
 
-void ULifeComponent::ResetInvicibility()
+bool ULifeComponent::IsInvincible() const
 {
-	isInvicible = false;
-	GetWorld()->GetTimerManager().ClearTimer(invicibleTimer);
+	return GetWorld()->GetTimeSeconds() < invincibleUntil;
+}
+
+void ULifeComponent::OnInvincibilityExpired(float expiryTime)
+{
+	// Revived or hurt again since, a later expiry is on its way
+	if (expiryTime != invincibleUntil)
+		return;
 
 	if (OnInvicibilityStop.IsBound())
 		OnInvicibilityStop.Broadcast();
@@ -46,3 +55,10 @@ void ULifeComponent::SetLife(int value)
 		Kill();
 }
 
+
+void ULifeComponent::Revive(int value)
+{
+	invincibleUntil = -1.f;
+
+	SetLife(value);
+}
@@ -20,12 +20,8 @@ class GLADIATORGAME_API ULifeComponent : public UActorComponent
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Life, meta = (AllowPrivateAccess = "true"))
 	int maxLife = 5;
 
-	FTimerHandle invicibleTimer;
-
-	bool isInvicible;
-
-	UFUNCTION()
-	void ResetInvicibility();
+	/** World time the invincibility from the last hit ends */
+	float invincibleUntil = -1.f;
 
 public:	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Life, meta = (AllowPrivateAccess = "true"))
@@ -39,6 +35,14 @@ public:
 
 	void SetLife(int value);
 
+	/** Back to value life and no invincibility, for pooled characters coming back */
+	void Revive(int value);
+
+	bool IsInvincible() const;
+
+	/** Called by the combat subsystem once the invincibility ran out, stale calls are ignored */
+	void OnInvincibilityExpired(float expiryTime);
+
 public:
 	int GetLife() { return life; }
 	int GetMaxLife() { return maxLife; }
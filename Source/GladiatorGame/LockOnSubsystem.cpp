@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LockOnSubsystem.h"
+#include "GladiatorStats.h"
+#include "GladiatorGameCharacter.h"
+#include "GladiatorSpatialSubsystem.h"
+
+AGladiatorGameCharacter* ULockOnSubsystem::FindBestTarget(const AGladiatorGameCharacter* seeker, const FVector& viewLocation, const FVector& viewDirection, float minDistance, float maxDistance)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorLockOn);
+
+	UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>();
+	if (!spatial)
+		return nullptr;
+
+	const float minCos = FMath::Cos(FMath::DegreesToRadians(softLockMaxAngle));
+	const FVector seekerLocation = seeker->GetActorLocation();
+
+	AGladiatorGameCharacter* best = nullptr;
+	float bestScore = MAX_flt;
+
+	spatial->ForEachInRange(seekerLocation, minDistance, maxDistance, seeker, [&](AGladiatorGameCharacter* gladiator, const FVector& location, float distSquared)
+	{
+		// Angle from the center of the screen, seen from the camera rather than the seeker
+		const float cosAngle = FVector::DotProduct((location - viewLocation).GetSafeNormal(), viewDirection);
+		if (cosAngle < minCos)
+			return;
+
+		const float angle = FMath::Acos(FMath::Clamp(cosAngle, -1.f, 1.f));
+		const float score = angleWeight * angle / FMath::DegreesToRadians(FMath::Max(softLockMaxAngle, 1.f))
+			+ distanceWeight * FMath::Sqrt(distSquared) / FMath::Max(maxDistance, 1.f);
+
+		if (score < bestScore)
+		{
+			best = gladiator;
+			bestScore = score;
+		}
+	});
+
+	return best;
+}
+
+bool ULockOnSubsystem::IsTargetValid(const AGladiatorGameCharacter* seeker, const AGladiatorGameCharacter* target, float maxDistance)
+{
+	GLADIATOR_SCOPE(STAT_GladiatorLockOn);
+
+	UGladiatorSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UGladiatorSpatialSubsystem>();
+	if (!spatial || !target)
+		return false;
+
+	// Dead gladiators leave the spatial subsystem, so an unknown target is a lost one
+	FVector location;
+	if (!spatial->GetCachedLocation(target, location))
+		return false;
+
+	const float breakDistance = maxDistance * breakDistanceScale;
+	return FVector::DistSquared(seeker->GetActorLocation(), location) <= breakDistance * breakDistance;
+}
+
+AGladiatorGameCharacter* ULockOnSubsystem::UpdateTarget(const AGladiatorGameCharacter* seeker, AGladiatorGameCharacter* target, const FVector& viewLocation, const FVector& viewDirection, float minDistance, float maxDistance)
+{
+	if (IsTargetValid(seeker, target, maxDistance))
+		return target;
+
+	return FindBestTarget(seeker, viewLocation, viewDirection, minDistance, maxDistance);
+}
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LockOnSubsystem.generated.h"
+
+class AGladiatorGameCharacter;
+
+/**
+ * Picks and keeps lock-on targets from the positions cached by the gladiator spatial subsystem.
+ * Keeping a target costs one lookup a frame, candidates are only scored again when it is lost.
+ */
+UCLASS(config = Game)
+class GLADIATORGAME_API ULockOnSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Targets further than this from the view direction are never picked, in degrees */
+	UPROPERTY(config)
+	float softLockMaxAngle = 60.f;
+
+	/** Weight of the view angle against the distance when scoring targets */
+	UPROPERTY(config)
+	float angleWeight = 1.f;
+
+	UPROPERTY(config)
+	float distanceWeight = 0.5f;
+
+	/** A locked target is only lost this much past the max lock distance, so it does not flicker at the edge */
+	UPROPERTY(config)
+	float breakDistanceScale = 1.2f;
+
+	/** Best target for a view, nullptr if none is in range and in front of the camera */
+	AGladiatorGameCharacter* FindBestTarget(const AGladiatorGameCharacter* seeker, const FVector& viewLocation, const FVector& viewDirection, float minDistance, float maxDistance);
+
+	/** True while target is alive and within the break distance of seeker */
+	bool IsTargetValid(const AGladiatorGameCharacter* seeker, const AGladiatorGameCharacter* target, float maxDistance);
+
+	/** Keeps target while it is valid, otherwise hands off to the best target of the view */
+	AGladiatorGameCharacter* UpdateTarget(const AGladiatorGameCharacter* seeker, AGladiatorGameCharacter* target, const FVector& viewLocation, const FVector& viewDirection, float minDistance, float maxDistance);
+};
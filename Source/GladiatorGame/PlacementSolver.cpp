@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlacementSolver.h"
+#include "GladiatorStats.h"
+#include "EnemySnapshot.h"
+#include "BTT_PlaceAroundPlayer.h"
+#include "NavigationSystem.h"
+#include "GameFramework/Pawn.h"
+#include "Async/ParallelFor.h"
+
+void ProjectPointsOnNavigableLocation(const TArray<FVector>& points, TArray<FNavigationProjectionWork>& projectionWork, const APawn* pawn, UWorld* world)
+{
+	projectionWork.Reset(points.Num());
+	for (const FVector& point : points)
+		projectionWork.Emplace(point);
+
+	UNavigationSystemV1* navSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(world);
+	const ANavigationData* navData = navSys && pawn ? navSys->GetNavDataForProps(pawn->GetNavAgentPropertiesRef()) : nullptr;
+	if (!navData)
+		return;
+
+	GLADIATOR_COUNT_NAV_PROJECTIONS(projectionWork.Num());
+
+	// One query for the whole batch instead of one per candidate
+	navData->BatchProjectPoints(projectionWork, navData->GetConfig().DefaultQueryExtent);
+}
+
+FPlacementResult FPlacementSolver::Solve(const FPlacementRequest& request, const FEnemySnapshot& snapshot, UWorld* world)
+{
+	FPlacementResult result;
+
+	const int32 count = FMath::Max(request.candidateCount, 1);
+
+	FVector playerEnemyDir = request.enemyLocation - request.playerLocation;
+	playerEnemyDir.Normalize();
+
+	FRandomStream stream(request.seed);
+
+	candidates.Reset(count);
+	for (int32 i = 0; i < count; i++)
+		candidates.Add(request.playerLocation + GetRandomPointInSemiTorus(request.distanceMin, request.distanceMax, playerEnemyDir, stream));
+
+	ProjectPointsOnNavigableLocation(candidates, projectionWork, request.pawn, world);
+
+	scores.SetNumUninitialized(count, false);
+	statuses.SetNumUninitialized(count, false);
+
+	// Read only work on the snapshot, each candidate writes its own slot
+	ParallelFor(count, [&](int32 i)
+	{
+		scores[i] = -MAX_flt;
+
+		const FNavigationProjectionWork& work = projectionWork[i];
+		if (!work.bResult)
+		{
+			statuses[i] = ECandidateStatus::OFF_NAV_MESH;
+			return;
+		}
+
+		const FVector location = work.OutLocation.Location;
+
+		const float playerDistance = FVector::Dist(location, request.playerLocation);
+		if (playerDistance < request.distanceMin || playerDistance > request.distanceMax)
+		{
+			statuses[i] = ECandidateStatus::OUT_OF_RANGE;
+			return;
+		}
+
+		if (snapshot.IsSegmentBlockedByPlaced(location, request.playerLocation, request.pawn))
+		{
+			statuses[i] = ECandidateStatus::LINE_OF_FIRE;
+			return;
+		}
+
+		if (snapshot.IsPlacedEnemyInSphere(location, request.roomRadius, request.pawn))
+		{
+			statuses[i] = ECandidateStatus::CROWDED;
+			return;
+		}
+
+		// Short walks first, then the middle of the ring
+		const float ringMiddle = (request.distanceMin + request.distanceMax) * 0.5f;
+		scores[i] = -FVector::Dist(location, request.enemyLocation) - FMath::Abs(playerDistance - ringMiddle);
+		statuses[i] = ECandidateStatus::VALID;
+	},
+	count < minParallelCandidates);
+
+	int32 bestIndex = INDEX_NONE;
+	for (int32 i = 0; i < count; i++)
+	{
+		switch (statuses[i])
+		{
+		case ECandidateStatus::OFF_NAV_MESH:
+			result.rejectedOffNavMesh++;
+			break;
+		case ECandidateStatus::OUT_OF_RANGE:
+			result.rejectedOutOfRange++;
+			break;
+		case ECandidateStatus::LINE_OF_FIRE:
+			result.rejectedLineOfFire++;
+			break;
+		case ECandidateStatus::CROWDED:
+			result.rejectedCrowded++;
+			break;
+		case ECandidateStatus::VALID:
+			// Strictly greater keeps the lowest index on ties, so the pick does not depend on thread timing
+			if (bestIndex == INDEX_NONE || scores[i] > scores[bestIndex])
+				bestIndex = i;
+			break;
+		}
+	}
+
+	if (bestIndex != INDEX_NONE)
+	{
+		result.found = true;
+		result.location = projectionWork[bestIndex].OutLocation.Location;
+	}
+
+	return result;
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+
+class APawn;
+class UWorld;
+struct FEnemySnapshot;
+
+struct FPlacementRequest
+{
+	const APawn* pawn = nullptr;
+	FVector enemyLocation = FVector::ZeroVector;
+	FVector playerLocation = FVector::ZeroVector;
+
+	float distanceMin = 0.f;
+	float distanceMax = 0.f;
+	float roomRadius = 0.f;
+
+	int32 candidateCount = 16;
+	int32 seed = 0;
+};
+
+struct FPlacementResult
+{
+	FVector location = FVector::ZeroVector;
+	bool found = false;
+
+	int32 rejectedOffNavMesh = 0;
+	int32 rejectedOutOfRange = 0;
+	int32 rejectedLineOfFire = 0;
+	int32 rejectedCrowded = 0;
+};
+
+/**
+ * Picks a place around the player by scoring a batch of semi-torus candidates at once.
+ * Buffers are kept between solves so a solve does not allocate once warmed up.
+ */
+class GLADIATORGAME_API FPlacementSolver
+{
+public:
+	/** Candidates are projected on the nav mesh on the calling thread, then scored in parallel against the snapshot */
+	FPlacementResult Solve(const FPlacementRequest& request, const FEnemySnapshot& snapshot, UWorld* world);
+
+	/** Below this many candidates scoring stays on the calling thread, the manager's default of 16 is scored in parallel */
+	int32 minParallelCandidates = 8;
+
+private:
+	enum class ECandidateStatus : uint8
+	{
+		VALID,
+		OFF_NAV_MESH,
+		OUT_OF_RANGE,
+		LINE_OF_FIRE,
+		CROWDED
+	};
+
+	TArray<FVector> candidates;
+	TArray<FNavigationProjectionWork> projectionWork;
+	TArray<float> scores;
+	TArray<ECandidateStatus> statuses;
+};
+
+/** Projects all the points with a single nav mesh query, bResult stays false for the ones off the nav mesh */
+void ProjectPointsOnNavigableLocation(const TArray<FVector>& points, TArray<FNavigationProjectionWork>& projectionWork, const APawn* pawn, UWorld* world);
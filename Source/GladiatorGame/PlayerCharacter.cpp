@@ -7,6 +7,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GladiatorGameState.h"
+#include "LockOnSubsystem.h"
 
 APlayerCharacter::APlayerCharacter() 
 	: AGladiatorGameCharacter()
@@ -41,6 +42,7 @@ void APlayerCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerIn
 	PlayerInputComponent->BindAction("Jump", IE_Released, this, &ACharacter::StopJumping);
 
 	PlayerInputComponent->BindAction("LockOn", IE_Pressed, this, &APlayerCharacter::SetCameraLock);
+	PlayerInputComponent->BindAction("LockOnNext", IE_Pressed, this, &APlayerCharacter::CycleCameraLock);
 
 	PlayerInputComponent->BindAxis("MoveForward", this, &APlayerCharacter::MoveForward);
 	PlayerInputComponent->BindAxis("MoveRight", this, &APlayerCharacter::MoveRight);
@@ -63,8 +65,20 @@ void APlayerCharacter::Tick(float DeltaTime)
 
 void APlayerCharacter::CameraLock()
 {
-	if (cameraLockTarget)
-		LookAtTarget(cameraLockTarget, lockOnSpeed);
+	if (!isLocking)
+		return;
+
+	ULockOnSubsystem* lockOn = GetWorld()->GetSubsystem<ULockOnSubsystem>();
+	if (lockOn)
+		cameraLockTarget = lockOn->UpdateTarget(this, cameraLockTarget, followCameraComp->GetComponentLocation(), followCameraComp->GetForwardVector(), minLockOnDistance, maxLockOnDistance);
+
+	if (!cameraLockTarget)
+	{
+		SetCameraLockOff();
+		return;
+	}
+
+	LookAtTarget(cameraLockTarget, lockOnSpeed);
 }
 
 void APlayerCharacter::SetCameraLock()
@@ -76,7 +90,13 @@ void APlayerCharacter::SetCameraLockOn()
 {
 	isLocking = true;
 
-	cameraLockTarget = GetOtherGladiator(minLockOnDistance, maxLockOnDistance);
+	ULockOnSubsystem* lockOn = GetWorld()->GetSubsystem<ULockOnSubsystem>();
+	if (lockOn)
+		cameraLockTarget = lockOn->FindBestTarget(this, followCameraComp->GetComponentLocation(), followCameraComp->GetForwardVector(), minLockOnDistance, maxLockOnDistance);
+
+	// Nothing in front of the camera, fall back to the closest gladiator
+	if (!cameraLockTarget)
+		cameraLockTarget = GetOtherGladiator(minLockOnDistance, maxLockOnDistance);
 
 	if (!cameraLockTarget)
 		SetCameraLockOff();
@@ -86,4 +106,14 @@ void APlayerCharacter::SetCameraLockOff()
 {
 	isLocking = false;
 	cameraLockTarget = nullptr;
-}
\ No newline at end of file
+}
+
+void APlayerCharacter::CycleCameraLock()
+{
+	if (!isLocking)
+		return;
+
+	AGladiatorGameCharacter* next = GetNextGladiator(minLockOnDistance, maxLockOnDistance, cameraLockTarget);
+	if (next)
+		cameraLockTarget = next;
+}
@@ -14,6 +14,7 @@ class GLADIATORGAME_API APlayerCharacter : public AGladiatorGameCharacter
 {
 	GENERATED_BODY()
 
+	UPROPERTY()
 	AGladiatorGameCharacter* cameraLockTarget;
 
 	UPROPERTY(EditAnywhere)
@@ -42,6 +43,10 @@ public:
 	void SetCameraLockOn();
 	void SetCameraLockOff();
 
+	/** Moves the lock to the next gladiator further away */
+	UFUNCTION()
+	void CycleCameraLock();
+
 	void Tick(float DeltaTime) override;
 
 
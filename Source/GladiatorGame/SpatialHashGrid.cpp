@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SpatialHashGrid.h"
+
+void FSpatialHashGrid::SetCellSize(float size)
+{
+	cellSize = FMath::Max(size, 1.f);
+	invCellSize = 1.f / cellSize;
+}
+
+void FSpatialHashGrid::Build(const float* positionsX, const float* positionsY, int32 count)
+{
+	// Twice as many buckets as items keeps collisions rare, the arrays only grow
+	const uint32 bucketCount = FMath::RoundUpToPowerOfTwo(FMath::Max(count * 2, 64));
+	bucketMask = bucketCount - 1;
+
+	bucketStarts.Reset();
+	bucketStarts.AddZeroed(bucketCount + 1);
+
+	itemBuckets.SetNumUninitialized(count, false);
+	itemCells.SetNumUninitialized(count, false);
+	sortedItems.SetNumUninitialized(count, false);
+	sortedCells.SetNumUninitialized(count, false);
+
+	for (int32 i = 0; i < count; i++)
+	{
+		const FIntPoint cell = GetCell(positionsX[i], positionsY[i]);
+		const uint32 bucket = HashCell(cell.X, cell.Y);
+
+		itemCells[i] = cell;
+		itemBuckets[i] = bucket;
+		bucketStarts[bucket + 1]++;
+	}
+
+	for (uint32 bucket = 0; bucket < bucketCount; bucket++)
+		bucketStarts[bucket + 1] += bucketStarts[bucket];
+
+	// Counting sort, bucketStarts[b] is the write cursor of bucket b and ends on the start of b + 1
+	for (int32 i = 0; i < count; i++)
+	{
+		const int32 slot = bucketStarts[itemBuckets[i]]++;
+		sortedItems[slot] = i;
+		sortedCells[slot] = itemCells[i];
+	}
+
+	// Every start moved up by one bucket, shift them back
+	for (uint32 bucket = bucketCount; bucket > 0; bucket--)
+		bucketStarts[bucket] = bucketStarts[bucket - 1];
+	bucketStarts[0] = 0;
+}
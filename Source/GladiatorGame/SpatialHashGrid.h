@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over the XY plane, rebuilt from scratch from a position array.
+ * Cells are hashed into buckets so the grid needs no world bounds.
+ */
+class GLADIATORGAME_API FSpatialHashGrid
+{
+public:
+	void SetCellSize(float size);
+	float GetCellSize() const { return cellSize; }
+
+	/** Buckets items 0..count-1, the arrays are only read during the call */
+	void Build(const float* positionsX, const float* positionsY, int32 count);
+
+	/** Calls func(itemIndex) once for every item whose cell touches the circle, callers test the exact distance */
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& center, float radius, FuncType&& func) const
+	{
+		if (sortedItems.Num() == 0)
+			return;
+
+		const FIntPoint minCell = GetCell(center.X - radius, center.Y - radius);
+		const FIntPoint maxCell = GetCell(center.X + radius, center.Y + radius);
+
+		for (int32 y = minCell.Y; y <= maxCell.Y; y++)
+		{
+			for (int32 x = minCell.X; x <= maxCell.X; x++)
+			{
+				const uint32 bucket = HashCell(x, y);
+				const FIntPoint cell(x, y);
+
+				for (int32 i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; i++)
+				{
+					// Other cells can share the bucket
+					if (sortedCells[i] == cell)
+						func(sortedItems[i]);
+				}
+			}
+		}
+	}
+
+private:
+	float cellSize = 200.f;
+	float invCellSize = 1.f / 200.f;
+	uint32 bucketMask = 0;
+
+	TArray<int32> bucketStarts;
+	TArray<int32> sortedItems;
+	TArray<FIntPoint> sortedCells;
+
+	TArray<uint32> itemBuckets;
+	TArray<FIntPoint> itemCells;
+
+	FIntPoint GetCell(float x, float y) const
+	{
+		return FIntPoint(FMath::FloorToInt(x * invCellSize), FMath::FloorToInt(y * invCellSize));
+	}
+
+	uint32 HashCell(int32 x, int32 y) const
+	{
+		return ((uint32)x * 73856093u ^ (uint32)y * 19349663u) & bucketMask;
+	}
+};
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponAttachment.h"
+#include "GladiatorGame.h"
+#include "GladiatorGameCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "EngineUtils.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice componentsCommand(
+		TEXT("gladiator.ComponentStats"),
+		TEXT("Prints the components, ticking components and memory of the living gladiators, per gladiator"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& args, UWorld* world, FOutputDevice& ar)
+		{
+			ar.Log(FGladiatorComponentStats::Gather(world).ToString());
+		}));
+}
+
+FGladiatorComponentStats FGladiatorComponentStats::Gather(UWorld* world)
+{
+	FGladiatorComponentStats stats;
+
+	for (TActorIterator<AGladiatorGameCharacter> it(world); it; ++it)
+	{
+		// Pooled enemies are asleep and would lower the averages
+		if (!it->isAlive())
+			continue;
+
+		stats.gladiators++;
+		stats.bytes += it->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		for (UActorComponent* component : it->GetComponents())
+		{
+			if (!component->IsRegistered())
+				continue;
+
+			stats.registered++;
+			stats.bytes += component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+			if (component->IsComponentTickEnabled())
+				stats.ticking++;
+
+			if (component->IsA<USkeletalMeshComponent>())
+				stats.skeletalMeshes++;
+		}
+	}
+
+	return stats;
+}
+
+FString FGladiatorComponentStats::ToString() const
+{
+	if (gladiators == 0)
+		return TEXT("No living gladiators");
+
+	return FString::Printf(TEXT("%d gladiators, per gladiator: %.1f registered components, %.1f ticking, %.1f skeletal meshes, %.1f KB"),
+		gladiators, (float)registered / gladiators, (float)ticking / gladiators, (float)skeletalMeshes / gladiators, bytes / 1024.f / gladiators);
+}
+
+void FWeaponAttachment::Init(USkeletalMeshComponent* inSkeletal)
+{
+	skeletal = inSkeletal;
+	holder = Cast<USkeletalMeshComponent>(skeletal->GetAttachParent());
+	socket = skeletal->GetAttachSocketName();
+	relativeTransform = skeletal->GetRelativeTransform();
+
+	if (renderMode == EWeaponRenderMode::STATIC && !staticMesh)
+	{
+		// Once per weapon mesh, every spawn of the same blueprint would say the same
+		static TSet<const UObject*> warnedMeshes;
+		const UObject* mesh = skeletal->SkeletalMesh;
+
+		bool alreadyWarned = false;
+		warnedMeshes.Add(mesh, &alreadyWarned);
+
+		if (!alreadyWarned)
+			UE_LOG(LogGladiator, Warning, TEXT("%s of %s is set to Static without a static mesh, it stays a skeletal mesh"), *skeletal->GetName(), *GetNameSafe(skeletal->GetOwner()->GetClass()));
+	}
+
+	if (renderMode == EWeaponRenderMode::STATIC && staticMesh && !staticComponent)
+	{
+		AActor* owner = skeletal->GetOwner();
+
+		// Hits are traced by the weapon trace, the weapon in the hand needs no collision
+		staticComponent = NewObject<UStaticMeshComponent>(owner, *(skeletal->GetName() + TEXT("Static")));
+		staticComponent->SetStaticMesh(staticMesh);
+		staticComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		staticComponent->SetCanEverAffectNavigation(false);
+		staticComponent->SetupAttachment(holder, socket);
+		staticComponent->SetRelativeTransform(relativeTransform);
+		staticComponent->RegisterComponent();
+		owner->AddInstanceComponent(staticComponent);
+	}
+
+	Hold();
+}
+
+void FWeaponAttachment::Hold()
+{
+	if (UsesStatic())
+	{
+		// No bone update, proxy, tick or physics state until Drop
+		if (skeletal->IsRegistered())
+			skeletal->UnregisterComponent();
+
+		staticComponent->SetVisibility(true);
+	}
+	else if (renderMode == EWeaponRenderMode::MASTER_POSE && holder)
+	{
+		skeletal->SetMasterPoseComponent(holder);
+	}
+}
+
+void FWeaponAttachment::Drop(FName collisionProfile)
+{
+	if (UsesStatic())
+	{
+		staticComponent->SetVisibility(false);
+		skeletal->RegisterComponent();
+	}
+	else if (renderMode == EWeaponRenderMode::MASTER_POSE)
+	{
+		skeletal->SetMasterPoseComponent(nullptr);
+	}
+
+	skeletal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	skeletal->SetSimulatePhysics(true);
+	skeletal->SetCollisionProfileName(collisionProfile);
+}
+
+void FWeaponAttachment::Reattach(FName collisionProfile)
+{
+	skeletal->SetSimulatePhysics(false);
+	skeletal->bNoSkeletonUpdate = false;
+	skeletal->SetComponentTickEnabled(true);
+	skeletal->SetVisibility(true);
+	skeletal->SetCollisionProfileName(collisionProfile);
+
+	skeletal->AttachToComponent(holder, FAttachmentTransformRules::SnapToTargetNotIncludingScale, socket);
+	skeletal->SetRelativeTransform(relativeTransform);
+
+	Hold();
+}
+
+UPrimitiveComponent* FWeaponAttachment::GetVisibleComponent() const
+{
+	if (UsesStatic() && staticComponent->IsVisible())
+		return staticComponent;
+
+	return skeletal;
+}
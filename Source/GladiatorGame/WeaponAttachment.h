@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponAttachment.generated.h"
+
+class UPrimitiveComponent;
+class USkeletalMeshComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+class UWorld;
+
+UENUM(BlueprintType)
+enum class EWeaponRenderMode : uint8 {
+	SKELETAL	UMETA(DisplayName = "Skeletal"),
+	STATIC		UMETA(DisplayName = "Static"),
+	MASTER_POSE	UMETA(DisplayName = "Master Pose")
+};
+
+/**
+ * How a weapon is rendered in the hand of a living gladiator.
+ * STATIC shows staticMesh on the socket, the weapon's skeletal mesh is only registered as the prop dropped on death.
+ * MASTER_POSE keeps the skeletal mesh but has it follow the body's bones, for weapons skinned to the body skeleton.
+ */
+USTRUCT(BlueprintType)
+struct GLADIATORGAME_API FWeaponAttachment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Weapon)
+	EWeaponRenderMode renderMode = EWeaponRenderMode::STATIC;
+
+	/** Pivot on the skeletal mesh's root. Also the instance left by a frozen corpse */
+	UPROPERTY(EditAnywhere, Category = Weapon)
+	UStaticMesh* staticMesh = nullptr;
+
+	/** Sets up the weapon for its render mode, skeletal is its physics prop and stays as placed in the socket */
+	void Init(USkeletalMeshComponent* inSkeletal);
+
+	/** The skeletal mesh takes over as a simulated prop */
+	void Drop(FName collisionProfile);
+
+	/** Back in the socket after Drop */
+	void Reattach(FName collisionProfile);
+
+	/** The component showing the weapon right now */
+	UPrimitiveComponent* GetVisibleComponent() const;
+
+	USkeletalMeshComponent* GetSkeletalComponent() const { return skeletal; }
+
+private:
+	UPROPERTY(Transient)
+	USkeletalMeshComponent* skeletal = nullptr;
+
+	UPROPERTY(Transient)
+	UStaticMeshComponent* staticComponent = nullptr;
+
+	/** The body mesh holding the weapon */
+	UPROPERTY(Transient)
+	USkeletalMeshComponent* holder = nullptr;
+
+	FName socket;
+	FTransform relativeTransform;
+
+	bool UsesStatic() const { return staticComponent != nullptr; }
+	void Hold();
+};
+
+/** Averages over the living gladiators of a world, to compare the weapon render modes */
+struct GLADIATORGAME_API FGladiatorComponentStats
+{
+	int32 gladiators = 0;
+	int32 registered = 0;
+	int32 ticking = 0;
+	int32 skeletalMeshes = 0;
+	SIZE_T bytes = 0;
+
+	static FGladiatorComponentStats Gather(UWorld* world);
+
+	FString ToString() const;
+};
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WeaponTraceComponent.h"
+#include "GladiatorStats.h"
+
+UWeaponTraceComponent::UWeaponTraceComponent()
+{
+	// After the animation moved the weapon for this frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UWeaponTraceComponent::SetTracedComponent(USceneComponent* component, FName socket)
+{
+	tracedComponent = component;
+	tracedSocket = socket;
+}
+
+FVector UWeaponTraceComponent::GetTracedLocation() const
+{
+	return tracedSocket.IsNone() ? tracedComponent->GetComponentLocation() : tracedComponent->GetSocketLocation(tracedSocket);
+}
+
+bool UWeaponTraceComponent::GetPivotTransform(FTransform& pivot) const
+{
+	USceneComponent* parent = tracedComponent->GetAttachParent();
+	if (!parent)
+		return false;
+
+	pivot = parent->GetSocketTransform(tracedComponent->GetAttachSocketName());
+	return true;
+}
+
+void UWeaponTraceComponent::BeginSwing()
+{
+	if (!tracedComponent)
+		return;
+
+	hitActors.Reset();
+	lastLocation = GetTracedLocation();
+	GetPivotTransform(lastPivot);
+	SetComponentTickEnabled(true);
+}
+
+void UWeaponTraceComponent::EndSwing()
+{
+	SetComponentTickEnabled(false);
+	hitActors.Reset();
+}
+
+void UWeaponTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!tracedComponent)
+		return;
+
+	const FVector location = GetTracedLocation();
+	const float length = FVector::Dist(lastLocation, location);
+	const int32 sweeps = FMath::Clamp(FMath::CeilToInt(length / FMath::Max(maxSweepLength, 1.f)), 1, FMath::Max(maxSweepsPerFrame, 1));
+
+	FCollisionQueryParams params(SCENE_QUERY_STAT(WeaponTrace), false, GetOwner());
+
+	FTransform pivot;
+	const bool hasPivot = GetPivotTransform(pivot);
+
+	// The points in between turn with the hand from its last transform to this one, the sweeps follow the arc and not the chord
+	FVector start = lastLocation;
+	if (hasPivot && sweeps > 1)
+	{
+		const FVector localPoint = pivot.InverseTransformPosition(location);
+
+		FTransform between;
+		for (int32 i = 1; i < sweeps; i++)
+		{
+			between.Blend(lastPivot, pivot, (float)i / sweeps);
+
+			const FVector end = between.TransformPosition(localPoint);
+			Sweep(start, end, params);
+			start = end;
+		}
+	}
+
+	Sweep(start, location, params);
+
+	lastPivot = pivot;
+	lastLocation = location;
+}
+
+void UWeaponTraceComponent::Sweep(const FVector& start, const FVector& end, const FCollisionQueryParams& params)
+{
+	GLADIATOR_COUNT_PHYSICS_QUERIES(1);
+
+	sweepHits.Reset();
+	GetWorld()->SweepMultiByChannel(sweepHits, start, end, FQuat::Identity, ECC_GladiatorHit, FCollisionShape::MakeSphere(radius), params);
+
+	for (const FHitResult& hit : sweepHits)
+	{
+		AActor* victim = hit.GetActor();
+		if (!victim || hitActors.Contains(victim))
+			continue;
+
+		hitActors.Add(victim);
+		OnWeaponHit.Broadcast(victim, hit);
+	}
+}
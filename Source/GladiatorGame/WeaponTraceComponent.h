@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WeaponTraceComponent.generated.h"
+
+/** Trace channel only gladiators answer to, set up in DefaultEngine.ini */
+#define ECC_GladiatorHit ECC_GameTraceChannel1
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FWeaponHitDelegate, AActor* /*victim*/, const FHitResult& /*hit*/);
+
+/**
+ * Sweeps a sphere along the path a weapon point took since the last frame while a swing is on.
+ * Long moves are cut in a few sweeps along the rotation of the hand holding the weapon, so fast swings follow their arc.
+ * Each actor is hit once per swing.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class GLADIATORGAME_API UWeaponTraceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	USceneComponent* tracedComponent;
+
+	FName tracedSocket;
+
+	FVector lastLocation;
+
+	/** Socket the traced component hangs from, as it was last frame */
+	FTransform lastPivot;
+
+	/** Actors already hit during the current swing */
+	TArray<AActor*, TInlineAllocator<8>> hitActors;
+
+	TArray<FHitResult> sweepHits;
+
+public:
+	UWeaponTraceComponent();
+
+	/** Radius of the swept sphere */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Trace)
+	float radius = 32.f;
+
+	/** A move longer than this is cut in several sweeps along the swing's arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Trace)
+	float maxSweepLength = 40.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Trace)
+	int maxSweepsPerFrame = 4;
+
+	/** Called once per actor and per swing */
+	FWeaponHitDelegate OnWeaponHit;
+
+	/** The point swept is the socket of component, or the component itself with no socket */
+	void SetTracedComponent(USceneComponent* component, FName socket = NAME_None);
+
+	void BeginSwing();
+	void EndSwing();
+
+	bool IsSwinging() const { return IsComponentTickEnabled(); }
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	FVector GetTracedLocation() const;
+
+	/** False when the traced component is not attached, its moves are then swept in a straight line */
+	bool GetPivotTransform(FTransform& pivot) const;
+
+	void Sweep(const FVector& start, const FVector& end, const FCollisionQueryParams& params);
+};